@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    ChannelMatrix.cpp
+    Created: 20 Oct 2026 4:20:33pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "ChannelMatrix.h"
+
+
+//==============================================================================
+ChannelMatrix::ChannelMatrix()
+{
+    //every possible route, so update() never allocates
+    mRoutes.reserve(static_cast<size_t>(maxChannels * maxChannels));
+}
+
+//==============================================================================
+void ChannelMatrix::setOutputLayout(const AudioChannelSet& layout)
+{
+    mNumOutputs = jmin(layout.size(), static_cast<int>(maxChannels));
+    mLeftIndex = layout.getChannelIndexForType(AudioChannelSet::left);
+    mRightIndex = layout.getChannelIndexForType(AudioChannelSet::right);
+    mIsAmbisonic = layout.getAmbisonicOrder() >= 0;
+
+    //rebuilt on the next block
+    mNumSources = -1;
+}
+
+
+void ChannelMatrix::setCustomMatrix(const String& text)
+{
+    std::vector<float> gains;
+    int numOutputs = 0, numSources = 0;
+
+    for(auto& row : StringArray::fromTokens(text, ";", {}))
+    {
+        auto values = StringArray::fromTokens(row, " \t,", {});
+        values.removeEmptyStrings();
+
+        if(values.isEmpty())
+            continue;
+
+        //every row needs one gain per sample channel
+        if(numOutputs > 0 && values.size() != numSources)
+        {
+            gains.clear();
+            numOutputs = numSources = 0;
+            break;
+        }
+
+        numSources = values.size();
+        numOutputs++;
+
+        for(auto& value : values)
+            gains.push_back(value.getFloatValue());
+    }
+
+    if(numOutputs > maxChannels || numSources > maxChannels)
+    {
+        gains.clear();
+        numOutputs = numSources = 0;
+    }
+
+    const SpinLock::ScopedLockType lock(mCustomLock);
+
+    mCustomText = gains.empty() ? String() : text.trim();
+    mCustomGains = std::move(gains);
+    mCustomNumOutputs = numOutputs;
+    mCustomNumSources = numSources;
+    mCustomVersion++;
+}
+
+
+String ChannelMatrix::getCustomMatrix() const
+{
+    const SpinLock::ScopedLockType lock(mCustomLock);
+    return mCustomText;
+}
+
+//==============================================================================
+void ChannelMatrix::update(int numSourceChannels) noexcept
+{
+    const int version = mCustomVersion.load();
+    const bool sourcesChanged = numSourceChannels != mNumSources;
+
+    if(! sourcesChanged && version == mAppliedVersion)
+        return;
+
+    const SpinLock::ScopedTryLockType lock(mCustomLock);
+
+    //the message thread is writing a new matrix, keep the routes unless they no longer fit
+    if(! lock.isLocked() && ! sourcesChanged)
+        return;
+
+    mNumSources = numSourceChannels;
+    mRoutes.clear();
+
+    if(lock.isLocked())
+    {
+        mAppliedVersion = version;
+
+        if(! mCustomGains.empty() && mCustomNumOutputs == mNumOutputs && mCustomNumSources == mNumSources)
+        {
+            for(int output = 0; output < mNumOutputs; output++)
+                for(int source = 0; source < mNumSources; source++)
+                    addRoute(source, output, mCustomGains[static_cast<size_t>(output * mNumSources + source)]);
+
+            return;
+        }
+    }
+
+    buildAutomaticRoutes();
+}
+
+//==============================================================================
+void ChannelMatrix::addRoute(int source, int output, float gain) noexcept
+{
+    if(gain != 0.f && mRoutes.size() < mRoutes.capacity())
+        mRoutes.push_back({ source, output, gain });
+}
+
+
+void ChannelMatrix::buildAutomaticRoutes() noexcept
+{
+    if(mNumSources <= 0 || mNumOutputs <= 0)
+        return;
+
+    //mono to every channel, on ambisonic buses only to the omnidirectional W
+    if(mNumSources == 1)
+    {
+        for(int output = 0; output < (mIsAmbisonic ? 1 : mNumOutputs); output++)
+            addRoute(0, output, 1.f);
+
+        return;
+    }
+
+    if(mNumSources == 2 && mNumOutputs != 2)
+    {
+        if(mNumOutputs == 1 || mIsAmbisonic)
+        {
+            addRoute(0, 0, 0.5f);
+            addRoute(1, 0, 0.5f);
+            return;
+        }
+
+        if(mLeftIndex >= 0 && mRightIndex >= 0)
+        {
+            addRoute(0, mLeftIndex, 1.f);
+            addRoute(1, mRightIndex, 1.f);
+            return;
+        }
+    }
+
+    //same order on both sides, extra channels on either side stay unused
+    for(int channel = 0; channel < jmin(mNumSources, mNumOutputs); channel++)
+        addRoute(channel, channel, 1.f);
+}
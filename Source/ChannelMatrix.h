@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    ChannelMatrix.h
+    Created: 20 Oct 2026 4:20:33pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MixKernels.h"
+
+
+//==============================================================================
+/**
+ Routes the channels of the sample to the channels of the output bus.
+
+ Without a custom matrix the routing follows the bus layout: a mono sample
+ goes to every channel (only to W on ambisonic buses), a stereo sample goes
+ to the left and right channels, and anything else goes channel by channel.
+
+ A custom matrix has one row per output channel and one gain per sample
+ channel, e.g. "1 0; 0 1; 0.5 0.5". It is only used while its size matches
+ the bus and the sample, otherwise the automatic routing applies.
+
+ The routing is kept as a list of non-zero routes, so mixing costs one
+ vectorized multiply-add per route and grows linearly with the channel count.
+*/
+class ChannelMatrix
+{
+public:
+    static constexpr int maxChannels = 64;
+
+    ChannelMatrix();
+
+    //==============================================================================
+    //prepareToPlay, before the audio thread runs
+    void setOutputLayout(const AudioChannelSet& layout);
+
+    //message thread, an empty string goes back to the automatic routing
+    void setCustomMatrix(const String& text);
+    String getCustomMatrix() const;
+
+    //==============================================================================
+    /*
+     Audio thread, once per block. Rebuilds the routes when the sample channel
+     count or the custom matrix changed, without allocating.
+     */
+    void update(int numSourceChannels) noexcept;
+
+    //dest[output] += source[input] * route gain * (gains[i] or gain)
+    template<typename SampleType>
+    void mix(SampleType* const* dest, int offset, const SampleType* const* source,
+             const float* gains, float gain, int numSamples) const noexcept
+    {
+        for(auto& route : mRoutes)
+        {
+            SampleType* channelData = dest[route.output] + offset;
+
+            if(gains != nullptr)
+                MixKernels::add(channelData, source[route.source], gains, route.gain, numSamples);
+            else
+                MixKernels::add(channelData, source[route.source], gain * route.gain, numSamples);
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Route
+    {
+        int source;
+        int output;
+        float gain;
+    };
+
+    void addRoute(int source, int output, float gain) noexcept;
+    void buildAutomaticRoutes() noexcept;
+
+    //==============================================================================
+    int mNumOutputs = 0;
+    int mLeftIndex = -1, mRightIndex = -1;
+    bool mIsAmbisonic = false;
+
+    int mNumSources = -1;
+    std::vector<Route> mRoutes;
+
+    //written by the message thread, copied by the audio thread under a try-lock
+    SpinLock mCustomLock;
+    String mCustomText;
+    std::vector<float> mCustomGains;
+    int mCustomNumOutputs = 0, mCustomNumSources = 0;
+    std::atomic<int> mCustomVersion { 0 };
+    int mAppliedVersion = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelMatrix)
+};
@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+    CompressedSampleData.cpp
+    Created: 20 Oct 2026 1:45:02pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "CompressedSampleData.h"
+
+
+namespace
+{
+    constexpr int maxOrder = 3;
+    constexpr int maxRiceParameter = 30;
+
+    uint32 lowMask(int numBits) noexcept
+    {
+        return numBits >= 32 ? 0xffffffffu : (1u << numBits) - 1u;
+    }
+
+    //fixed polynomial predictors, the first samples of a block use the orders they have history for
+    int32 predict(int order, int32 x1, int32 x2, int32 x3) noexcept
+    {
+        switch(order)
+        {
+            case 1:  return x1;
+            case 2:  return 2 * x1 - x2;
+            case 3:  return 3 * x1 - 3 * x2 + x3;
+            default: return 0;
+        }
+    }
+
+    uint32 zigzag(int32 value) noexcept
+    {
+        return (static_cast<uint32>(value) << 1) ^ static_cast<uint32>(value >> 31);
+    }
+
+    int32 unzigzag(uint32 value) noexcept
+    {
+        return static_cast<int32>(value >> 1) ^ -static_cast<int32>(value & 1u);
+    }
+}
+
+
+//==============================================================================
+CompressedSampleData::CompressedSampleData(const AudioBuffer<float>& buffer, double sampleRate, float durationInSec, int bitDepth)
+    : SampleData(buffer.getNumChannels(), buffer.getNumSamples(), sampleRate, durationInSec)
+{
+    jassert(bitDepth == 16 || bitDepth == 24);
+
+    //resampled material can peak above full scale, it is scaled down rather than clipped and scaled back up in decodeBlock
+    const int numSamples = buffer.getNumSamples();
+    const float peak = jmax(1.f, buffer.getMagnitude(0, numSamples));
+    const int32 maxValue = (1 << (jlimit(16, 24, bitDepth) - 1)) - 1;
+    const float scale = static_cast<float>(maxValue) / peak;
+
+    mInverseScale = 1.f / scale;
+
+    const int numChannels = buffer.getNumChannels();
+    const int numBlocks = (numSamples + blockSize - 1) / blockSize;
+    mHeaders.resize(static_cast<size_t>(numBlocks * numChannels));
+
+    int32 quantised[blockSize];
+
+    for(int block = 0; block < numBlocks; block++)
+    {
+        const int blockStart = block * blockSize;
+        const int blockLength = jmin(static_cast<int>(blockSize), numSamples - blockStart);
+
+        for(int channel = 0; channel < numChannels; channel++)
+        {
+            const float* source = buffer.getReadPointer(channel, blockStart);
+
+            for(int i = 0; i < blockLength; i++)
+                quantised[i] = jlimit(-maxValue, maxValue, roundToInt(source[i] * scale));
+
+            encodeBlock(quantised, blockLength, mHeaders[static_cast<size_t>(block * numChannels + channel)]);
+        }
+    }
+
+    //the decoder always peeks one word past the one it is in
+    mBits.resize(static_cast<size_t>((mNumBits + 31) / 32 + 2), 0);
+    mBits.shrink_to_fit();
+}
+
+//==============================================================================
+void CompressedSampleData::readSamples(float* const* dest, int numDestChannels, int startSample, int numSamples) noexcept
+{
+    decodeSamples(dest, numDestChannels, startSample, numSamples);
+}
+
+
+void CompressedSampleData::readSamples(double* const* dest, float* const*, int numDestChannels, int startSample, int numSamples) noexcept
+{
+    decodeSamples(dest, numDestChannels, startSample, numSamples);
+}
+
+
+size_t CompressedSampleData::getMemoryUsage() const noexcept
+{
+    return mBits.capacity() * sizeof(uint32) + mHeaders.capacity() * sizeof(BlockHeader);
+}
+
+//==============================================================================
+template<typename SampleType>
+void CompressedSampleData::decodeSamples(SampleType* const* dest, int numDestChannels, int startSample, int numSamples) const noexcept
+{
+    const int numToRead = jlimit(0, numSamples, getLengthInSamples() - startSample);
+    const int numReadChannels = numToRead > 0 ? jmin(numDestChannels, getNumChannels()) : 0;
+
+    for(int channel = 0; channel < numReadChannels; channel++)
+    {
+        for(int done = 0; done < numToRead;)
+        {
+            const int position = startSample + done;
+            const int block = position / blockSize;
+            const int skip = position - block * blockSize;
+            const int num = jmin(numToRead - done, static_cast<int>(blockSize) - skip);
+
+            decodeBlock(mHeaders[static_cast<size_t>(block * getNumChannels() + channel)], skip, num, dest[channel] + done);
+            done += num;
+        }
+    }
+
+    clearRemainder(dest, numDestChannels, numReadChannels, numToRead, numSamples);
+}
+
+
+void CompressedSampleData::encodeBlock(const int32* samples, int numSamples, BlockHeader& header)
+{
+    uint32 residuals[maxOrder + 1][blockSize];
+    uint64 costs[maxOrder + 1] = {};
+
+    for(int order = 0; order <= maxOrder; order++)
+    {
+        for(int i = 0; i < numSamples; i++)
+        {
+            const int32 prediction = predict(jmin(order, i),
+                                             i > 0 ? samples[i - 1] : 0,
+                                             i > 1 ? samples[i - 2] : 0,
+                                             i > 2 ? samples[i - 3] : 0);
+
+            residuals[order][i] = zigzag(samples[i] - prediction);
+            costs[order] += residuals[order][i];
+        }
+    }
+
+    const int order = static_cast<int>(std::min_element(costs, costs + maxOrder + 1) - costs);
+    const uint32* residual = residuals[order];
+
+    //the exact size for every Rice parameter, the smallest wins
+    int riceParameter = 0;
+    uint64 bestSize = std::numeric_limits<uint64>::max();
+
+    for(int k = 0; k <= maxRiceParameter; k++)
+    {
+        uint64 size = static_cast<uint64>(numSamples) * static_cast<uint64>(k + 1);
+
+        for(int i = 0; i < numSamples; i++)
+            size += residual[i] >> k;
+
+        if(size < bestSize)
+        {
+            bestSize = size;
+            riceParameter = k;
+        }
+    }
+
+    header.bitOffset = mNumBits;
+    header.order = static_cast<uint8>(order);
+    header.riceParameter = static_cast<uint8>(riceParameter);
+
+    for(int i = 0; i < numSamples; i++)
+    {
+        //quotient in unary, a run of zeros closed by a one
+        for(uint32 quotient = residual[i] >> riceParameter; quotient > 0;)
+        {
+            const int num = static_cast<int>(jmin(quotient, 32u));
+            writeBits(0, num);
+            quotient -= static_cast<uint32>(num);
+        }
+
+        writeBits(1, 1);
+
+        if(riceParameter > 0)
+            writeBits(residual[i] & lowMask(riceParameter), riceParameter);
+    }
+}
+
+
+template<typename SampleType>
+void CompressedSampleData::decodeBlock(const BlockHeader& header, int skip, int numSamples, SampleType* dest) const noexcept
+{
+    const uint32* bits = mBits.data();
+    const int riceParameter = header.riceParameter;
+    const int order = header.order;
+
+    //the next 32 bits from position on
+    auto peek = [bits] (int64 position) noexcept
+    {
+        const auto word = static_cast<size_t>(position >> 5);
+        const uint64 both = (static_cast<uint64>(bits[word]) << 32) | bits[word + 1];
+        return static_cast<uint32>((both << (position & 31)) >> 32);
+    };
+
+    int64 position = header.bitOffset;
+    int32 x1 = 0, x2 = 0, x3 = 0;
+    const int end = skip + numSamples;
+
+    for(int i = 0; i < end; i++)
+    {
+        uint32 quotient = 0;
+
+        for(;;)
+        {
+            const uint32 window = peek(position);
+
+            if(window != 0)
+            {
+                const int numZeros = 31 - findHighestSetBit(window);
+                quotient += static_cast<uint32>(numZeros);
+                position += numZeros + 1;
+                break;
+            }
+
+            quotient += 32;
+            position += 32;
+        }
+
+        uint32 value = quotient << riceParameter;
+
+        if(riceParameter > 0)
+        {
+            value |= peek(position) >> (32 - riceParameter);
+            position += riceParameter;
+        }
+
+        const int32 sample = unzigzag(value) + predict(jmin(order, i), x1, x2, x3);
+
+        if(i >= skip)
+            dest[i - skip] = static_cast<SampleType>(sample) * static_cast<SampleType>(mInverseScale);
+
+        x3 = x2;
+        x2 = x1;
+        x1 = sample;
+    }
+}
+
+
+void CompressedSampleData::writeBits(uint32 value, int numBits)
+{
+    while(numBits > 0)
+    {
+        const auto word = static_cast<size_t>(mNumBits >> 5);
+        if(word >= mBits.size())
+            mBits.push_back(0);
+
+        const int free = 32 - static_cast<int>(mNumBits & 31);
+        const int num = jmin(free, numBits);
+        const uint32 chunk = (value >> (numBits - num)) & lowMask(num);
+
+        mBits[word] |= chunk << (free - num);
+        numBits -= num;
+        mNumBits += num;
+    }
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    CompressedSampleData.h
+    Created: 20 Oct 2026 1:45:02pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+
+
+//==============================================================================
+/**
+ A resident sample quantised to 16 or 24 bits, then losslessly coded.
+
+ The quantisation is the only lossy step. Material peaking above full scale
+ is scaled down first rather than clipped, and the scale is undone when
+ decoding, so it plays at the same level as the float path. The integers
+ are cut into blocks of 256 frames per channel. Each block is coded like a FLAC subframe: the best of the fixed
+ polynomial predictors of order 0 to 3, followed by Rice coded residuals. This
+ typically takes 2 to 4 times less memory than planar float.
+
+ Blocks are independent, so readSamples decodes straight into dest from the
+ start of the block holding startSample. A call never decodes more than
+ numSamples + 255 samples per channel, and keeps no state, so one object can
+ still be shared by every instance. The cost per decoded sample is measured
+ by repeator-bench --bit-depth=16 or 24, and --max-ns fails the run when it
+ goes over a limit.
+*/
+class CompressedSampleData : public SampleData
+{
+public:
+    //bitDepth is 16 or 24
+    CompressedSampleData(const AudioBuffer<float>& buffer, double sampleRate, float durationInSec, int bitDepth);
+
+    void readSamples(float* const* dest, int numDestChannels, int startSample, int numSamples) noexcept override;
+
+    //decodes straight to double, the scratch isn't needed
+    void readSamples(double* const* dest, float* const* scratch, int numDestChannels, int startSample, int numSamples) noexcept override;
+
+    //bytes held for the coded blocks and their headers
+    size_t getMemoryUsage() const noexcept;
+
+    static constexpr int blockSize = 256;
+
+private:
+    //==============================================================================
+    struct BlockHeader
+    {
+        int64 bitOffset;
+        uint8 order;
+        uint8 riceParameter;
+    };
+
+    void encodeBlock(const int32* samples, int numSamples, BlockHeader& header);
+    template<typename SampleType>
+    void decodeSamples(SampleType* const* dest, int numDestChannels, int startSample, int numSamples) const noexcept;
+
+    template<typename SampleType>
+    void decodeBlock(const BlockHeader& header, int skip, int numSamples, SampleType* dest) const noexcept;
+
+    void writeBits(uint32 value, int numBits);
+
+    //==============================================================================
+    //undoes both the integer range and the peak scaling, so decoded samples match the float source
+    float mInverseScale = 1.f;
+
+    //one header per block and channel, block major
+    std::vector<BlockHeader> mHeaders;
+
+    //the coded bits, most significant bit first
+    std::vector<uint32> mBits;
+    int64 mNumBits = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompressedSampleData)
+};
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    EmbeddedSample.cpp
+    Created: 23 Oct 2026 2:12:37pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "EmbeddedSample.h"
+
+
+namespace
+{
+    //keeps the sample it reads from alive as long as the reader
+    class EmbeddedInputStream : public InputStream
+    {
+    public:
+        EmbeddedInputStream(EmbeddedSample::Ptr sample)
+            : mSample(sample), mStream(mSample->getData(), false) {}
+
+        int64 getTotalLength() override { return mStream.getTotalLength(); }
+        bool isExhausted() override { return mStream.isExhausted(); }
+        int read(void* dest, int numBytes) override { return mStream.read(dest, numBytes); }
+        int64 getPosition() override { return mStream.getPosition(); }
+        bool setPosition(int64 position) override { return mStream.setPosition(position); }
+
+    private:
+        EmbeddedSample::Ptr mSample;
+        MemoryInputStream mStream;
+    };
+
+    //FLAC only takes integer samples up to 24 bits and 8 channels
+    bool encodeFlac(AudioFormatReader& reader, MemoryBlock& dest)
+    {
+        if(reader.usesFloatingPointData || reader.bitsPerSample > 24 || reader.numChannels > 8)
+            return false;
+
+        FlacAudioFormat flac;
+        auto* stream = new MemoryOutputStream(dest, false);
+
+        std::unique_ptr<AudioFormatWriter> writer(flac.createWriterFor(stream, reader.sampleRate, reader.numChannels,
+                                                                       static_cast<int>(reader.bitsPerSample), {}, 5));
+        if(writer == nullptr)
+        {
+            delete stream;
+            return false;
+        }
+
+        return writer->writeFromAudioReader(reader, 0, -1);
+    }
+}
+
+
+//==============================================================================
+EmbeddedSample::EmbeddedSample(const String& path, MemoryBlock data, const String& hash)
+    : mPath(path), mData(std::move(data)), mHash(hash)
+{
+}
+
+
+EmbeddedSample::Ptr EmbeddedSample::create(Registry& registry, AudioFormatManager& formatManager, const File& file)
+{
+    MemoryBlock original;
+    if(! file.loadFileAsData(original))
+        return nullptr;
+
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if(reader == nullptr)
+        return nullptr;
+
+    //the original bytes are kept when they are already smaller, an Ogg file for example
+    MemoryBlock flac;
+    if(encodeFlac(*reader, flac) && flac.getSize() < original.getSize())
+        original = std::move(flac);
+
+    const String hash = SHA256(original).toHexString();
+    return share(registry, new EmbeddedSample(file.getFullPathName(), std::move(original), hash));
+}
+
+
+EmbeddedSample::Ptr EmbeddedSample::create(Registry& registry, const String& path, MemoryBlock data, const String& hash)
+{
+    if(data.isEmpty())
+        return nullptr;
+
+    //the registry shares samples by hash, so a stored one is never trusted
+    const String actualHash = SHA256(data).toHexString();
+
+    //the data was damaged since it was saved, the file on disk is played instead
+    if(hash.isNotEmpty() && ! hash.equalsIgnoreCase(actualHash))
+        return nullptr;
+
+    return share(registry, new EmbeddedSample(path, std::move(data), actualHash));
+}
+
+
+EmbeddedSample::Ptr EmbeddedSample::share(Registry& registry, EmbeddedSample* sample)
+{
+    Ptr created(sample);
+
+    const ScopedLock sl(registry.mLock);
+
+    //samples only the registry still refers to
+    for(auto entry = registry.mSamples.begin(); entry != registry.mSamples.end();)
+    {
+        if(entry->second->getReferenceCount() == 1)
+            entry = registry.mSamples.erase(entry);
+        else
+            ++entry;
+    }
+
+    const String key = created->mHash + "|" + created->mPath;
+    auto entry = registry.mSamples.find(key);
+
+    if(entry != registry.mSamples.end())
+        return entry->second;
+
+    registry.mSamples.emplace(key, created);
+    return created;
+}
+
+//==============================================================================
+std::unique_ptr<AudioFormatReader> EmbeddedSample::createReader(AudioFormatManager& formatManager)
+{
+    return std::unique_ptr<AudioFormatReader>(formatManager.createReaderFor(std::make_unique<EmbeddedInputStream>(Ptr(this))));
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    EmbeddedSample.h
+    Created: 23 Oct 2026 2:12:37pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <map>
+
+
+//==============================================================================
+/**
+ A user sample carried inside the plugin state, so a session restores without
+ the original file.
+
+ Integer files up to 24 bits are stored as FLAC, anything else (float WAVs,
+ or files FLAC doesn't make smaller) as the bytes of the original file. The
+ data is identified by its SHA-256, which is what SampleLoader keys the
+ decoded sample on, so instances embedding the same file decode it once.
+
+ Instances embedding or restoring the same data also share one EmbeddedSample
+ through the Registry instead of holding a copy each.
+*/
+class EmbeddedSample : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<EmbeddedSample>;
+
+    //the samples in use, held by every loader through a SharedResourcePointer
+    class Registry
+    {
+    public:
+        Registry() = default;
+
+    private:
+        friend class EmbeddedSample;
+
+        CriticalSection mLock;
+        std::map<String, Ptr> mSamples;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Registry)
+    };
+
+    //reads and encodes the file, nullptr when it can't be read
+    static Ptr create(Registry& registry, AudioFormatManager& formatManager, const File& file);
+
+    //wraps data restored from a state, nullptr when it doesn't match the hash saved with it
+    static Ptr create(Registry& registry, const String& path, MemoryBlock data, const String& hash = {});
+
+    //==============================================================================
+    //where the file was when it was embedded, used to match it to the menu entry
+    const String& getPath() const noexcept { return mPath; }
+    const MemoryBlock& getData() const noexcept { return mData; }
+    const String& getHash() const noexcept { return mHash; }
+
+    //decodes from memory, the reader keeps this object alive
+    std::unique_ptr<AudioFormatReader> createReader(AudioFormatManager& formatManager);
+
+private:
+    //==============================================================================
+    EmbeddedSample(const String& path, MemoryBlock data, const String& hash);
+
+    static Ptr share(Registry& registry, EmbeddedSample* sample);
+
+    const String mPath;
+    const MemoryBlock mData;
+    const String mHash;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EmbeddedSample)
+};
@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+    LoadMeter.cpp
+    Created: 22 Oct 2026 3:18:44pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "LoadMeter.h"
+
+
+namespace
+{
+    constexpr float minLoad = 1.0e-5f;
+    constexpr int bucketsPerOctave = 8;
+
+    int getBucket(float load) noexcept
+    {
+        if(load <= minLoad)
+            return 0;
+
+        const int bucket = static_cast<int>(std::log2(load / minLoad) * bucketsPerOctave);
+        return jmin(bucket, LoadMeter::numBuckets - 1);
+    }
+
+    //the load below which a share of the blocks lies, the top of the bucket it falls in
+    float getPercentile(const std::array<int64, LoadMeter::numBuckets>& counts, int64 total, double share, float max) noexcept
+    {
+        const auto target = static_cast<int64>(std::ceil(share * static_cast<double>(total)));
+        int64 sum = 0;
+
+        for(int bucket = 0; bucket < LoadMeter::numBuckets; bucket++)
+        {
+            sum += counts[static_cast<size_t>(bucket)];
+
+            if(sum >= target)
+                return jmin(max, LoadMeter::getBucketStart(bucket + 1));
+        }
+
+        return max;
+    }
+}
+
+
+//==============================================================================
+LoadMeter::LoadMeter(const StringArray& modeNames)
+    : mModeNames(modeNames)
+{
+    for(int mode = 0; mode < mModeNames.size(); mode++)
+        mModes.push_back(std::make_unique<ModeCounters>());
+}
+
+
+void LoadMeter::prepare(double sampleRate)
+{
+    const double ticksPerSecond = static_cast<double>(Time::getHighResolutionTicksPerSecond());
+
+    mTicksPerSample = ticksPerSecond / sampleRate;
+    mNanosecondsPerTick = 1.0e9 / ticksPerSecond;
+
+    clear();
+}
+
+//==============================================================================
+void LoadMeter::addBlock(int mode, int numSamples, int64 elapsedTicks) noexcept
+{
+    if(mResetRequested.exchange(false))
+        clear();
+
+    if(! isPositiveAndBelow(mode, static_cast<int>(mModes.size())) || numSamples <= 0 || mTicksPerSample <= 0.)
+        return;
+
+    auto& counters = *mModes[static_cast<size_t>(mode)];
+    const float load = static_cast<float>(static_cast<double>(elapsedTicks) / (numSamples * mTicksPerSample));
+
+    add(counters.buckets[static_cast<size_t>(getBucket(load))], int64 { 1 });
+    add(counters.numBlocks, int64 { 1 });
+    add(counters.numSamples, static_cast<int64>(numSamples));
+    add(counters.numTicks, elapsedTicks);
+    add(counters.loadSum, static_cast<double>(load));
+
+    if(load > counters.maxLoad.load(std::memory_order_relaxed))
+        counters.maxLoad.store(load, std::memory_order_relaxed);
+
+    if(load >= atRiskLoad)
+        add(counters.numAtRisk, int64 { 1 });
+
+    if(load > 1.f)
+        add(counters.numOverDeadline, int64 { 1 });
+}
+
+
+void LoadMeter::clear() noexcept
+{
+    for(auto& counters : mModes)
+    {
+        for(auto& bucket : counters->buckets)
+            bucket.store(0, std::memory_order_relaxed);
+
+        counters->numBlocks.store(0, std::memory_order_relaxed);
+        counters->numSamples.store(0, std::memory_order_relaxed);
+        counters->numTicks.store(0, std::memory_order_relaxed);
+        counters->numAtRisk.store(0, std::memory_order_relaxed);
+        counters->numOverDeadline.store(0, std::memory_order_relaxed);
+        counters->loadSum.store(0., std::memory_order_relaxed);
+        counters->maxLoad.store(0.f, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+LoadMeter::Stats LoadMeter::getStats(int mode) const
+{
+    Stats stats;
+    std::array<int64, numBuckets> counts;
+    getHistogram(mode, counts);
+
+    int64 numSamples = 0, numTicks = 0;
+    double loadSum = 0.;
+
+    for(int index = 0; index < static_cast<int>(mModes.size()); index++)
+    {
+        if(mode >= 0 && index != mode)
+            continue;
+
+        const auto& counters = *mModes[static_cast<size_t>(index)];
+        stats.numBlocks += counters.numBlocks.load(std::memory_order_relaxed);
+        stats.numAtRisk += counters.numAtRisk.load(std::memory_order_relaxed);
+        stats.numOverDeadline += counters.numOverDeadline.load(std::memory_order_relaxed);
+        stats.max = jmax(stats.max, counters.maxLoad.load(std::memory_order_relaxed));
+        numSamples += counters.numSamples.load(std::memory_order_relaxed);
+        numTicks += counters.numTicks.load(std::memory_order_relaxed);
+        loadSum += counters.loadSum.load(std::memory_order_relaxed);
+    }
+
+    if(stats.numBlocks == 0)
+        return stats;
+
+    //the counters are read while the audio thread writes them, the buckets decide the total
+    int64 total = 0;
+    for(auto count : counts)
+        total += count;
+
+    stats.mean = static_cast<float>(loadSum / static_cast<double>(stats.numBlocks));
+    stats.p50 = getPercentile(counts, total, 0.5, stats.max);
+    stats.p99 = getPercentile(counts, total, 0.99, stats.max);
+    stats.nsPerSample = numSamples > 0 ? static_cast<double>(numTicks) * mNanosecondsPerTick / static_cast<double>(numSamples) : 0.;
+    return stats;
+}
+
+
+void LoadMeter::getHistogram(int mode, std::array<int64, numBuckets>& counts) const
+{
+    counts.fill(0);
+
+    for(int index = 0; index < static_cast<int>(mModes.size()); index++)
+        if(mode < 0 || index == mode)
+            for(size_t bucket = 0; bucket < counts.size(); bucket++)
+                counts[bucket] += mModes[static_cast<size_t>(index)]->buckets[bucket].load(std::memory_order_relaxed);
+}
+
+
+float LoadMeter::getBucketStart(int bucket) noexcept
+{
+    return bucket <= 0 ? 0.f : minLoad * std::exp2(static_cast<float>(bucket) / bucketsPerOctave);
+}
+
+//==============================================================================
+String LoadMeter::toCsv() const
+{
+    String csv = "mode,blocks,mean_percent,p50_percent,p99_percent,max_percent,at_risk,over_deadline,ns_per_sample\n";
+
+    for(int mode = -1; mode < getNumModes(); mode++)
+    {
+        const Stats stats = getStats(mode);
+
+        csv << (mode < 0 ? String("all") : getModeName(mode)) << "," << stats.numBlocks << ","
+            << 100. * stats.mean << "," << 100. * stats.p50 << "," << 100. * stats.p99 << "," << 100. * stats.max << ","
+            << stats.numAtRisk << "," << stats.numOverDeadline << "," << stats.nsPerSample << "\n";
+    }
+
+    csv << "\nmode,from_percent,to_percent,blocks\n";
+
+    std::array<int64, numBuckets> counts;
+
+    for(int mode = 0; mode < getNumModes(); mode++)
+    {
+        getHistogram(mode, counts);
+
+        for(int bucket = 0; bucket < numBuckets; bucket++)
+            if(counts[static_cast<size_t>(bucket)] > 0)
+                csv << getModeName(mode) << "," << 100. * getBucketStart(bucket) << ","
+                    << 100. * getBucketStart(bucket + 1) << "," << counts[static_cast<size_t>(bucket)] << "\n";
+    }
+
+    return csv;
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    LoadMeter.h
+    Created: 22 Oct 2026 3:18:44pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+//==============================================================================
+/**
+ Times every processBlock call against its deadline, the duration of the block
+ at the current sample rate, and keeps a histogram of the load per playback
+ mode.
+
+ The audio thread is the only writer. It adds each block with a relaxed
+ increment, so recording costs two clock reads, a log2 and a few stores, and
+ the message thread reads the counters whenever it wants without locking. A
+ reset is only requested by the message thread and carried out by the audio
+ thread on its next block.
+
+ Buckets are logarithmic, 8 per octave from 0.001% to 1000% of the deadline,
+ so percentiles are accurate to about 9% of their value.
+*/
+class LoadMeter
+{
+public:
+    //one histogram per mode, modes are indices into modeNames
+    explicit LoadMeter(const StringArray& modeNames);
+
+    //==============================================================================
+    //prepareToPlay, before the audio thread runs, also clears everything
+    void prepare(double sampleRate);
+
+    //audio thread, after every block
+    void addBlock(int mode, int numSamples, int64 elapsedTicks) noexcept;
+
+    //message thread, the audio thread clears the counters on its next block
+    void reset() noexcept { mResetRequested.store(true); }
+
+    //==============================================================================
+    struct Stats
+    {
+        int64 numBlocks = 0;
+
+        //fractions of the block deadline, 1 is the whole budget
+        float mean = 0.f, p50 = 0.f, p99 = 0.f, max = 0.f;
+
+        //blocks above half of the deadline, and blocks that missed it
+        int64 numAtRisk = 0, numOverDeadline = 0;
+
+        double nsPerSample = 0.;
+    };
+
+    //message thread, mode -1 is every mode together
+    Stats getStats(int mode = -1) const;
+
+    int getNumModes() const noexcept { return mModeNames.size(); }
+    const String& getModeName(int mode) const noexcept { return mModeNames.getReference(mode); }
+
+    //the share of the blocks of one mode, or of all of them, in each bucket
+    static constexpr int numBuckets = 160;
+    void getHistogram(int mode, std::array<int64, numBuckets>& counts) const;
+    static float getBucketStart(int bucket) noexcept;
+
+    //a summary per mode, then the non-empty buckets of every mode, loads in percent of the deadline
+    String toCsv() const;
+
+    static constexpr float atRiskLoad = 0.5f;
+
+private:
+    //==============================================================================
+    struct ModeCounters
+    {
+        std::array<std::atomic<int64>, numBuckets> buckets {};
+        std::atomic<int64> numBlocks { 0 };
+        std::atomic<int64> numSamples { 0 };
+        std::atomic<int64> numTicks { 0 };
+        std::atomic<int64> numAtRisk { 0 };
+        std::atomic<int64> numOverDeadline { 0 };
+        std::atomic<double> loadSum { 0. };
+        std::atomic<float> maxLoad { 0.f };
+    };
+
+    void clear() noexcept;
+
+    //single writer, so a plain load and store replace the read-modify-write
+    template<typename ValueType>
+    static void add(std::atomic<ValueType>& counter, ValueType amount) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    const StringArray mModeNames;
+    std::vector<std::unique_ptr<ModeCounters>> mModes;
+
+    double mTicksPerSample = 0.;
+    double mNanosecondsPerTick = 0.;
+    std::atomic<bool> mResetRequested { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadMeter)
+};
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    LoadMeterComponent.cpp
+    Created: 22 Oct 2026 4:40:09pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "LoadMeterComponent.h"
+
+
+namespace
+{
+    String formatLoad(float load)
+    {
+        return String(100. * load, load < 0.01f ? 3 : 1) + "%";
+    }
+}
+
+
+//==============================================================================
+LoadMeterComponent::LoadMeterComponent(LoadMeter& meter)
+    : mMeter(meter)
+{
+    addAndMakeVisible(mResetButton);
+    mResetButton.onClick = [this] { mMeter.reset(); repaint(); };
+
+    addAndMakeVisible(mExportButton);
+    mExportButton.onClick = [this] { exportCsv(); };
+}
+
+//==============================================================================
+void LoadMeterComponent::paint(Graphics& g)
+{
+    g.fillAll(Colours::black.withAlpha(0.9f));
+
+    auto area = getLocalBounds().reduced(10, 8).withTrimmedTop(22);
+    const int rowHeight = 14;
+
+    //one row per mode with blocks, then the total
+    g.setFont(Font(Font::getDefaultMonospacedFontName(), 11.f, Font::plain));
+    g.setColour(Colours::grey);
+    String header;
+    header << String("mode").paddedRight(' ', 8) << String("blocks").paddedLeft(' ', 9) << String("p50").paddedLeft(' ', 8)
+           << String("p99").paddedLeft(' ', 8) << String("max").paddedLeft(' ', 8) << String("at risk").paddedLeft(' ', 9);
+    g.drawText(header, area.removeFromTop(rowHeight), Justification::left);
+
+    for(int mode = -1; mode < mMeter.getNumModes(); mode++)
+    {
+        const auto stats = mMeter.getStats(mode);
+
+        if(mode >= 0 && stats.numBlocks == 0)
+            continue;
+
+        String row;
+        row << (mode < 0 ? String("all") : mMeter.getModeName(mode)).paddedRight(' ', 8)
+            << String(stats.numBlocks).paddedLeft(' ', 9) << formatLoad(stats.p50).paddedLeft(' ', 8)
+            << formatLoad(stats.p99).paddedLeft(' ', 8) << formatLoad(stats.max).paddedLeft(' ', 8)
+            << String(stats.numAtRisk).paddedLeft(' ', 9);
+
+        g.setColour(stats.numOverDeadline > 0 ? Colours::red : (stats.numAtRisk > 0 ? Colours::orange : Colours::white));
+        g.drawText(row, area.removeFromTop(rowHeight), Justification::left);
+    }
+
+    //the histogram of all blocks, log scale from 0.001% to 1000% of the deadline
+    auto graph = area.withTrimmedTop(6).withTrimmedBottom(30).toFloat();
+    if(graph.getHeight() < 10.f)
+        return;
+
+    std::array<int64, LoadMeter::numBuckets> counts;
+    mMeter.getHistogram(-1, counts);
+
+    const int64 maxCount = jmax(int64 { 1 }, *std::max_element(counts.begin(), counts.end()));
+    const float barWidth = graph.getWidth() / LoadMeter::numBuckets;
+
+    for(int bucket = 0; bucket < LoadMeter::numBuckets; bucket++)
+    {
+        const float height = graph.getHeight() * static_cast<float>(counts[static_cast<size_t>(bucket)]) / static_cast<float>(maxCount);
+        const float load = LoadMeter::getBucketStart(bucket);
+
+        g.setColour(load >= 1.f ? Colours::red : (load >= LoadMeter::atRiskLoad ? Colours::orange : Colours::lightgreen));
+        g.fillRect(graph.getX() + bucket * barWidth, graph.getBottom() - height, jmax(1.f, barWidth - 0.5f), height);
+    }
+
+    //markers at 1%, 10% and the whole deadline
+    g.setColour(Colours::grey);
+    for(float load : { 0.01f, 0.1f, 1.f })
+    {
+        const float x = graph.getX() + graph.getWidth() * std::log2(load / 1.0e-5f) * 8.f / LoadMeter::numBuckets;
+        g.drawVerticalLine(roundToInt(x), graph.getY(), graph.getBottom());
+        g.drawText(formatLoad(load), Rectangle<float>(x - 30.f, graph.getY() - 2.f, 60.f, 12.f), Justification::centred);
+    }
+}
+
+
+void LoadMeterComponent::resized()
+{
+    auto buttons = getLocalBounds().reduced(10, 8).removeFromBottom(22);
+
+    mExportButton.setBounds(buttons.removeFromRight(100));
+    buttons.removeFromRight(6);
+    mResetButton.setBounds(buttons.removeFromRight(60));
+}
+
+
+void LoadMeterComponent::visibilityChanged()
+{
+    if(isVisible())
+        startTimerHz(4);
+    else
+        stopTimer();
+}
+
+//==============================================================================
+void LoadMeterComponent::exportCsv()
+{
+    mChooser = std::make_unique<FileChooser>("Export the processing load as CSV...",
+                                             File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("Repeator load.csv"),
+                                             "*.csv");
+
+    const auto flags = FileBrowserComponent::saveMode | FileBrowserComponent::canSelectFiles | FileBrowserComponent::warnAboutOverwriting;
+
+    mChooser->launchAsync(flags, [this] (const FileChooser& chooser)
+    {
+        const File file = chooser.getResult();
+
+        if(file != File())
+            file.withFileExtension("csv").replaceWithText(mMeter.toCsv());
+    });
+}
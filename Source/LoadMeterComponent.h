@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    LoadMeterComponent.h
+    Created: 22 Oct 2026 4:40:09pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LoadMeter.h"
+
+
+//==============================================================================
+/**
+ The editor overlay for the LoadMeter: p50, p99 and max per mode as a share of
+ the block deadline, and the histogram of every block. Refreshes a few times
+ a second while visible.
+*/
+class LoadMeterComponent : public Component,
+                           private Timer
+{
+public:
+    LoadMeterComponent(LoadMeter& meter);
+
+    void paint(Graphics& g) override;
+    void resized() override;
+    void visibilityChanged() override;
+
+private:
+    void timerCallback() override { repaint(); }
+    void exportCsv();
+
+    LoadMeter& mMeter;
+
+    TextButton mResetButton { "Reset" };
+    TextButton mExportButton { "Export CSV..." };
+    std::unique_ptr<FileChooser> mChooser;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadMeterComponent)
+};
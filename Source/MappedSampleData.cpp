@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    MappedSampleData.cpp
+    Created: 17 Oct 2026 1:18:50pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "MappedSampleData.h"
+
+
+//==============================================================================
+SampleData::Ptr MappedSampleData::create(const File& file, double sampleRate, int numChannels)
+{
+    std::unique_ptr<MemoryMappedAudioFormatReader> reader;
+
+    if(file.hasFileExtension("wav"))
+        reader.reset(WavAudioFormat().createMemoryMappedReader(file));
+    else if(file.hasFileExtension("aif;aiff"))
+        reader.reset(AiffAudioFormat().createMemoryMappedReader(file));
+
+    if(reader == nullptr || reader->lengthInSamples <= 0)
+        return nullptr;
+
+    if(numChannels <= 0)
+        numChannels = static_cast<int>(reader->numChannels);
+
+    //other rates still have to go through the resampler
+    if(sampleRate > 0. && reader->sampleRate != sampleRate)
+        return nullptr;
+
+    if(! reader->mapEntireFile() || reader->getMappedSection().isEmpty())
+        return nullptr;
+
+    //fault the pages in here so the audio thread doesn't wait on the disk
+    const int64 samplesPerPage = jmax(1, 4096 / jmax(1, static_cast<int>(reader->numChannels * reader->bitsPerSample / 8)));
+
+    for(int64 i = 0; i < reader->lengthInSamples; i += samplesPerPage)
+        reader->touchSample(i);
+
+    return new MappedSampleData(std::move(reader), numChannels);
+}
+
+
+MappedSampleData::MappedSampleData(std::unique_ptr<MemoryMappedAudioFormatReader> reader, int numChannels)
+    : SampleData(numChannels,
+                 static_cast<int>(reader->lengthInSamples),
+                 reader->sampleRate,
+                 static_cast<float>(reader->lengthInSamples / reader->sampleRate)),
+      mReader(std::move(reader))
+{
+}
+
+//==============================================================================
+void MappedSampleData::readSamples(float* const* dest, int numDestChannels, int startSample, int numSamples) noexcept
+{
+    const int numToRead = jlimit(0, numSamples, getLengthInSamples() - startSample);
+    const int numReadChannels = numToRead > 0 ? jmin(numDestChannels, getNumChannels()) : 0;
+
+    //converts straight from the mapped PCM, channels the file doesn't have come back silent
+    if(numReadChannels > 0)
+        mReader->read(dest, numReadChannels, startSample, numToRead);
+
+    clearRemainder(dest, numDestChannels, numReadChannels, numToRead, numSamples);
+}
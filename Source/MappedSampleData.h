@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    MappedSampleData.h
+    Created: 17 Oct 2026 1:18:50pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+
+
+//==============================================================================
+/**
+ An uncompressed WAV or AIFF file played straight from a memory-mapped view.
+
+ Nothing is copied into the process, the pages belong to the OS file cache and
+ are shared by every instance and every process that plays the same file.
+ Only usable when the file rate already matches the host rate.
+*/
+class MappedSampleData : public SampleData
+{
+public:
+    //returns nullptr when the file can't be mapped or needs resampling
+    static SampleData::Ptr create(const File& file, double sampleRate, int numChannels);
+
+    using SampleData::readSamples;
+    void readSamples(float* const* dest, int numDestChannels, int startSample, int numSamples) noexcept override;
+
+private:
+    MappedSampleData(std::unique_ptr<MemoryMappedAudioFormatReader> reader, int numChannels);
+
+    std::unique_ptr<MemoryMappedAudioFormatReader> mReader;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MappedSampleData)
+};
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    MixKernels.h
+    Created: 17 Oct 2026 4:52:15pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+//==============================================================================
+/**
+ The inner loops of processBlock. Everything runs on whole runs of samples,
+ through FloatVectorOperations or loops simple enough for the compiler to
+ vectorize, so it vectorizes on every platform.
+*/
+namespace MixKernels
+{
+    //true if [position, position + numSamples) touches the fade in or fade out of a trigger
+    inline bool needsEdgeFade(int numSamples, int64 position, int64 duration, int fadeLength) noexcept
+    {
+        return fadeLength > 0 && (position < fadeLength || position + numSamples > duration - fadeLength);
+    }
+
+    //writes the trigger envelope, a linear ramp over fadeLength at both ends
+    inline void fillEdgeFade(float* dest, int numSamples, int64 position, int64 duration, int fadeLength) noexcept
+    {
+        const float step = 1.f / static_cast<float>(fadeLength);
+
+        for(int i = 0; i < numSamples; i++)
+        {
+            const int64 fromStart = position + i + 1;
+            const int64 toEnd = duration - position - i;
+            const float ramp = static_cast<float>(jmin(fromStart, toEnd)) * step;
+            dest[i] = jlimit(0.f, 1.f, ramp);
+        }
+    }
+
+    //==============================================================================
+    /*
+     The mixing kernels are written once for float and double output. Sources
+     may be float while the output is double, gains are always float.
+     */
+
+    //dest += src * gain
+    template<typename SampleType, typename SourceType>
+    inline void add(SampleType* dest, const SourceType* src, float gain, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, SourceType>)
+            FloatVectorOperations::addWithMultiply(dest, src, static_cast<SampleType>(gain), numSamples);
+        else
+            for(int i = 0; i < numSamples; i++)
+                dest[i] += static_cast<SampleType>(src[i]) * static_cast<SampleType>(gain);
+    }
+
+    //dest += src * gains[i]
+    template<typename SampleType, typename SourceType>
+    inline void add(SampleType* dest, const SourceType* src, const float* gains, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float> && std::is_same_v<SourceType, float>)
+            FloatVectorOperations::addWithMultiply(dest, src, gains, numSamples);
+        else
+            for(int i = 0; i < numSamples; i++)
+                dest[i] += static_cast<SampleType>(src[i]) * static_cast<SampleType>(gains[i]);
+    }
+
+    //dest += src * gains[i] * gain, one product per element so it vectorizes without reordering
+    template<typename SampleType>
+    inline void add(SampleType* dest, const SampleType* src, const float* gains, float gain, int numSamples) noexcept
+    {
+        for(int i = 0; i < numSamples; i++)
+            dest[i] += src[i] * static_cast<SampleType>(gains[i] * gain);
+    }
+
+    //dest *= 1 - envelope[i], how "silence" mutes the input with a fade
+    template<typename SampleType>
+    inline void duck(SampleType* dest, const float* envelope, float* scratch, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            FloatVectorOperations::negate(scratch, envelope, numSamples);
+            FloatVectorOperations::add(scratch, 1.f, numSamples);
+            FloatVectorOperations::multiply(dest, scratch, numSamples);
+        }
+        else
+        {
+            ignoreUnused(scratch);
+
+            for(int i = 0; i < numSamples; i++)
+                dest[i] *= static_cast<SampleType>(1.f - envelope[i]);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    NoiseGenerator.cpp
+    Created: 17 Oct 2026 3:47:31pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "NoiseGenerator.h"
+#include "MixKernels.h"
+
+
+namespace
+{
+    //lowbias32 integer hash, good enough for audio noise and cheap in SIMD
+    inline uint32 hash32(uint32 x) noexcept
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    //the old rand() noise was uniform in +-0.09, keep the same level
+    constexpr float whiteLevel = 0.09f;
+}
+
+//==============================================================================
+NoiseGenerator::NoiseGenerator()
+    : mSeed(static_cast<uint32>(Random::getSystemRandom().nextInt()))
+{
+}
+
+//==============================================================================
+void NoiseGenerator::reset() noexcept
+{
+    for(auto& filter : mFilters)
+        filter = {};
+}
+
+
+void NoiseGenerator::fillWhite(float* dest, int numSamples, int channel, int64 timelineSample) const noexcept
+{
+    //seed, channel and the upper counter bits go into the key, the low bits count samples
+    const uint32 key = hash32(mSeed ^ hash32(static_cast<uint32>(channel) * 0x9e3779b9u
+                                             ^ static_cast<uint32>(static_cast<uint64>(timelineSample) >> 32)));
+    const uint32 counter = static_cast<uint32>(timelineSample);
+
+    //independent lanes, no state carried between samples
+    for(int i = 0; i < numSamples; i++)
+    {
+        const uint32 h = hash32((counter + static_cast<uint32>(i)) ^ key);
+        dest[i] = static_cast<float>(static_cast<int32>(h)) * (whiteLevel / 2147483648.f);
+    }
+}
+
+
+void NoiseGenerator::addNoise(float* dest, int numSamples, int channel, int64 timelineSample, Colour colour, float gain) noexcept
+{
+    mixNoise(dest, numSamples, channel, timelineSample, colour, gain, nullptr);
+}
+
+
+void NoiseGenerator::addNoise(double* dest, int numSamples, int channel, int64 timelineSample, Colour colour, float gain) noexcept
+{
+    mixNoise(dest, numSamples, channel, timelineSample, colour, gain, nullptr);
+}
+
+
+void NoiseGenerator::addNoise(float* dest, int numSamples, int channel, int64 timelineSample, Colour colour, const float* gains) noexcept
+{
+    mixNoise(dest, numSamples, channel, timelineSample, colour, 0.f, gains);
+}
+
+
+void NoiseGenerator::addNoise(double* dest, int numSamples, int channel, int64 timelineSample, Colour colour, const float* gains) noexcept
+{
+    mixNoise(dest, numSamples, channel, timelineSample, colour, 0.f, gains);
+}
+
+
+template<typename SampleType>
+void NoiseGenerator::mixNoise(SampleType* dest, int numSamples, int channel, int64 timelineSample, Colour colour,
+                              float gain, const float* gains) noexcept
+{
+    auto& filter = mFilters[static_cast<size_t>(jlimit(0, maxChannels - 1, channel))];
+
+    for(int done = 0; done < numSamples;)
+    {
+        //runs never cross a 2^32 sample boundary, so the key stays the same within one
+        const int64 toBoundary = 0x100000000ll - ((timelineSample + done) & 0xffffffffll);
+        const int num = static_cast<int>(jmin(static_cast<int64>(jmin(scratchSize, numSamples - done)), toBoundary));
+        fillWhite(mScratch, num, channel, timelineSample + done);
+
+        if(colour == Colour::pink)
+        {
+            //Paul Kellet's economy pink filter
+            for(int i = 0; i < num; i++)
+            {
+                const float white = mScratch[i];
+                filter.b0 = 0.99765f * filter.b0 + white * 0.0990460f;
+                filter.b1 = 0.96300f * filter.b1 + white * 0.2965164f;
+                filter.b2 = 0.57000f * filter.b2 + white * 1.0526913f;
+                mScratch[i] = (filter.b0 + filter.b1 + filter.b2 + white * 0.1848f) * 0.25f;
+            }
+        }
+        else if(colour == Colour::brown)
+        {
+            //leaky integrator
+            for(int i = 0; i < num; i++)
+            {
+                filter.brown = (filter.brown + 0.02f * mScratch[i]) * (1.f / 1.02f);
+                mScratch[i] = filter.brown * 3.5f;
+            }
+        }
+
+        if(gains != nullptr)
+            MixKernels::add(dest + done, mScratch, gains + done, num);
+        else
+            MixKernels::add(dest + done, mScratch, gain, num);
+        done += num;
+    }
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    NoiseGenerator.h
+    Created: 17 Oct 2026 3:47:31pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+//==============================================================================
+/**
+ Realtime-safe noise for the "noise" mode.
+
+ White noise is a counter-based hash of (seed, channel, timeline sample), so
+ there is no shared RNG state and the inner loop has no dependency between
+ samples, which lets the compiler vectorize it. The same seed and timeline
+ position always give the same noise, so offline renders are deterministic.
+ Every instance starts from its own random seed, which the plugin state
+ keeps, so stems rendered in noise mode don't add up coherently in a mix.
+ Pink and brown are filtered from the white noise and reset on every trigger.
+*/
+class NoiseGenerator
+{
+public:
+    enum class Colour
+    {
+        white = 0,
+        pink,
+        brown
+    };
+
+    static constexpr int maxChannels = 64;
+
+    //==============================================================================
+    NoiseGenerator();
+
+    void setSeed(uint32 seed) noexcept { mSeed = seed; }
+    uint32 getSeed() const noexcept { return mSeed; }
+
+    //clears the pink and brown filters, called at the start of each trigger
+    void reset() noexcept;
+
+    /*
+     Adds gain * noise to dest for numSamples starting at timelineSample.
+     The noise itself is always generated in float.
+     */
+    void addNoise(float* dest, int numSamples, int channel, int64 timelineSample, Colour colour, float gain) noexcept;
+    void addNoise(double* dest, int numSamples, int channel, int64 timelineSample, Colour colour, float gain) noexcept;
+
+    //the same with a gain per sample, for ramps and fades
+    void addNoise(float* dest, int numSamples, int channel, int64 timelineSample, Colour colour, const float* gains) noexcept;
+    void addNoise(double* dest, int numSamples, int channel, int64 timelineSample, Colour colour, const float* gains) noexcept;
+
+private:
+    //==============================================================================
+    void fillWhite(float* dest, int numSamples, int channel, int64 timelineSample) const noexcept;
+
+    //gains is used when it isn't nullptr, otherwise the constant gain
+    template<typename SampleType>
+    void mixNoise(SampleType* dest, int numSamples, int channel, int64 timelineSample, Colour colour,
+                  float gain, const float* gains) noexcept;
+
+    struct FilterState
+    {
+        float b0 = 0.f, b1 = 0.f, b2 = 0.f;
+        float brown = 0.f;
+    };
+
+    uint32 mSeed;
+    std::array<FilterState, maxChannels> mFilters;
+
+    //scratch for one run of white noise, longer runs are split
+    static constexpr int scratchSize = 256;
+    alignas(16) float mScratch[scratchSize];
+};
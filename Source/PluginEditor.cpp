@@ -9,14 +9,21 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+//the Projucer build always bundles the font, the CMake one only when the asset is there
+#ifndef REPEATOR_HAS_UNICODE_FONT
+ #define REPEATOR_HAS_UNICODE_FONT 1
+#endif
+
 //==============================================================================
 RepeatorAudioProcessorEditor::RepeatorAudioProcessorEditor (RepeatorAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), mLoadMeterComponent (p.getLoadMeter())
 {
     setSize (400, 200);
     
+   #if REPEATOR_HAS_UNICODE_FONT
     //set default font from asset uniocode.ttf
     LookAndFeel::getDefaultLookAndFeel().setDefaultSansSerifTypeface(Typeface::createSystemTypefaceFor(BinaryData::unicode_ttf, BinaryData::unicode_ttfSize));
+   #endif
     
     //the order of the following code matters
     
@@ -66,7 +73,20 @@ RepeatorAudioProcessorEditor::RepeatorAudioProcessorEditor (RepeatorAudioProcess
     mLanguageMenu.onChange = [this] { LanguageChanged(); };
     
     
+    //==============================================================================
+    addChildComponent(mLoadMeterComponent);
+    
+    addAndMakeVisible(mLoadButton);
+    mLoadButton.setClickingTogglesState(true);
+    mLoadButton.onClick = [this] { mLoadMeterComponent.setVisible(mLoadButton.getToggleState()); };
+    
+    addAndMakeVisible(mEmbedButton);
+    mEmbedButton.setClickingTogglesState(true);
+    mEmbedButton.setToggleState(audioProcessor.isEmbeddingSample(), dontSendNotification);
+    mEmbedButton.setTooltip(TRANS("Save the selected sample inside the session"));
+    mEmbedButton.onClick = [this] { audioProcessor.setEmbedSample(mEmbedButton.getToggleState()); };
     
+    startTimerHz(4);
 }
 
 
@@ -84,6 +104,14 @@ void RepeatorAudioProcessorEditor::paint (juce::Graphics& g)
     g.setFont (20);
     g.setColour (juce::Colours::white);
     g.drawText ("Repeator", 150, 0, 100, 50, juce::Justification::centred);
+    
+    if(mLoadProgress.numFinished < mLoadProgress.numJobs)
+    {
+        g.setFont (12);
+        g.setColour (juce::Colours::grey);
+        g.drawText (TRANS("loading") + " " + String(mLoadProgress.numFinished) + "/" + String(mLoadProgress.numJobs),
+                    125, 35, 150, 15, juce::Justification::centred);
+    }
 }
 
 
@@ -94,16 +122,32 @@ void RepeatorAudioProcessorEditor::resized()
     mPeriodSLabel.setBounds(175, 92, 50, 20);
     mMenu.setBounds(10, 90, 100, 25);
     mLanguageMenu.setBounds(370, 5, 25, 25);
+    mEmbedButton.setBounds(315, 5, 50, 20);
+    
+    //the overlay covers everything but its own button
+    mLoadMeterComponent.setBounds(getLocalBounds());
+    mLoadButton.setBounds(10, 5, 40, 20);
+    mLoadButton.toFront(false);
+}
+
+
+void RepeatorAudioProcessorEditor::timerCallback()
+{
+    const auto progress = audioProcessor.getSampleLoaderPool().getProgress();
+    
+    if(progress.numJobs != mLoadProgress.numJobs || progress.numFinished != mLoadProgress.numFinished)
+    {
+        mLoadProgress = progress;
+        repaint();
+    }
 }
 
 //==============================================================================
 void RepeatorAudioProcessorEditor::MenuChanged()
 {
-    audioProcessor.mDuration = 1.f; //reset mDuration
-    
     //getSelectedId starts at 1, and selection list starts at 0
     mPreSelection = audioProcessor.mSelection;
-    audioProcessor.mSelection = mMenu.getSelectedId() - 1;
+    audioProcessor.setSelection(mMenu.getSelectedId() - 1);
     //select "load..."
     if(mMenu.getSelectedId() - 1 == audioProcessor.mArrSelect.indexOf(TRANS("load...")))
     {
@@ -145,8 +189,8 @@ void RepeatorAudioProcessorEditor::filesDropped(const StringArray& files, int, i
     
 void RepeatorAudioProcessorEditor::EditorLoadFile(File file)
 {
-    AudioFormatReader* reader = audioProcessor.mFormatManager.createReaderFor(file);
-    if(reader!=nullptr)
+    //only check the format here, the decode itself runs on the loader thread
+    if(file.existsAsFile() && audioProcessor.mFormatManager.findFormatForFileExtension(file.getFileExtension()) != nullptr)
     {
         audioProcessor.mFileName = file.getFileName();
         
@@ -155,7 +199,7 @@ void RepeatorAudioProcessorEditor::EditorLoadFile(File file)
         mMenu.clear();
         mMenu.addItemList(audioProcessor.mArrSelect, 1);
         
-        audioProcessor.loadFile(reader);
+        audioProcessor.loadFile(file);
         
         audioProcessor.mArrPath.add(file.getFullPathName());
         //indexOf("load...") is the current new file's index
@@ -163,7 +207,7 @@ void RepeatorAudioProcessorEditor::EditorLoadFile(File file)
     }
     else //loading cancelled or unsuccessful
     {
-        audioProcessor.mSelection = mPreSelection;
+        audioProcessor.setSelection(mPreSelection);
         mMenu.setSelectedId(mPreSelection + 1);
     }
 }
@@ -9,16 +9,19 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "BinaryData.h"
 #include "PluginProcessor.h"
 
 #include "ComboNoArrowLookAndFeel.h"
+#include "LoadMeterComponent.h"
 
 //==============================================================================
 /**
 */
 class RepeatorAudioProcessorEditor  :
 public AudioProcessorEditor,
-public FileDragAndDropTarget
+public FileDragAndDropTarget,
+private Timer
 {
 public:
     RepeatorAudioProcessorEditor (RepeatorAudioProcessor&);
@@ -48,8 +51,19 @@ private:
     juce::ComboBox mLanguageMenu;
     ComboNoArrowLookAndFeel mComboNoArrowLookAndFeel;
     
+    //processing load overlay, shown on demand
+    juce::TextButton mLoadButton { "CPU" };
+    LoadMeterComponent mLoadMeterComponent;
+    
+    //keep the selected sample inside the session
+    juce::TextButton mEmbedButton { "Embed" };
+    
     int mPreSelection;
     
+    //session load progress of every instance, shown while samples decode
+    SampleLoaderPool::Progress mLoadProgress;
+    void timerCallback() override;
+    
     void MenuChanged();
     void LanguageChanged();
     
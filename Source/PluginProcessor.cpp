@@ -7,7 +7,9 @@
 */
 
 #include "PluginProcessor.h"
+#include "BinaryData.h"
 #include "PluginEditor.h"
+#include "MixKernels.h"
 
 
 //==============================================================================
@@ -57,7 +59,6 @@ RepeatorAudioProcessor::RepeatorAudioProcessor()
 
 RepeatorAudioProcessor::~RepeatorAudioProcessor()
 {
-    mAudioBuffer.clear();
     mArrSelect.clear();
 }
 
@@ -126,7 +127,27 @@ void RepeatorAudioProcessor::changeProgramName (int index, const juce::String& n
 //==============================================================================
 void RepeatorAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    mBlockInSec = samplesPerBlock / sampleRate;
+    mScheduler.setSampleRate(sampleRate);
+    mNextSamplePosition = -1;
+    
+    //20 ms gain ramps and 5 ms fades at the trigger edges
+    mSmoothedGain.reset(sampleRate, 0.02);
+    mLoadMeter.prepare(sampleRate);
+    mFadeLength = juce::roundToInt(sampleRate * 0.005);
+    mGainScratch.setSize(numGainScratchChannels, jmax(1, samplesPerBlock));
+    
+    //samples keep the channels of their file, up to the most the matrix can route
+    mSampleScratch.setSize(ChannelMatrix::maxChannels, jmax(1, samplesPerBlock));
+    mChannelMatrix.setOutputLayout(getChannelLayoutOfBus(false, 0));
+    
+    //in double precision the samples are held as double too, so blocks need no conversion
+    const bool isDoublePrecision = getProcessingPrecision() == doublePrecision;
+    mSampleLoader.setDoublePrecision(isDoublePrecision);
+    mSampleScratchDouble.setSize(isDoublePrecision ? ChannelMatrix::maxChannels : 0, isDoublePrecision ? jmax(1, samplesPerBlock) : 0);
+    
+    //the sample was made for another rate or precision, rebuild it in the background
+    if(! mSampleLoader.isRequestedFor(sampleRate, fileChannels))
+        reloadSample();
 }
 
 void RepeatorAudioProcessor::releaseResources()
@@ -142,12 +163,10 @@ bool RepeatorAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout up to 64 channels: surround, immersive and ambisonic stems.
+    // The ChannelMatrix maps the sample onto whatever the bus is.
+    const auto& outputSet = layouts.getMainOutputChannelSet();
+    if (outputSet.isDisabled() || outputSet.size() > ChannelMatrix::maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -163,6 +182,23 @@ bool RepeatorAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 
 void RepeatorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    juce::ignoreUnused (midiMessages);
+    processSamples (buffer);
+}
+
+void RepeatorAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused (midiMessages);
+    processSamples (buffer);
+}
+
+//==============================================================================
+template<typename SampleType>
+void RepeatorAudioProcessor::processSamples (juce::AudioBuffer<SampleType>& buffer)
+{
+    //checker builds report anything in here that allocates, locks or blocks
+    const RealtimeCheck::ScopedRealtime realtime;
+    const int64 startTicks = Time::getHighResolutionTicks();
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -170,55 +206,35 @@ void RepeatorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     
     mPeriod = static_cast<float> (mAPVTS.getRawParameterValue("PERIOD")->load());
     
-    //Those variables may be changed to be member variables
-    AudioPlayHead* PlayHead = getPlayHead();
-    Optional<juce::AudioPlayHead::PositionInfo> PositionInfo = PlayHead->getPosition();
-    Optional<double> timeInSeconds = PositionInfo->getTimeInSeconds();
-    mTimeInSec = static_cast<float>(std::move(*timeInSeconds));
+    //pick up a sample the loader finished since the last block
+    if(mSampleLoader.updateCurrentSample())
+        mNextSamplePosition = -1;
+    
+    SampleData* sample = mSampleLoader.getCurrentSample();
     
     /*
      ProcessBlock may be called by the host even the transport is not playing.
-     mIsMoving determines the transport playing status.
+     Positions are 64-bit samples so triggers stay sample-accurate on long timelines.
      */
-    if(mCurrentPos == mTimeInSec)
-    {
-        mIsMoving = false;
-    }
-    else{
-        mIsMoving = true;
-    }
-    
-    //if the user changed the playback position
-    if(abs(mCurrentPos - mTimeInSec) > mBlockInSec * 2)
-    {
-        mLastPos = mTimeInSec;
-        mCurrentPos = mLastPos; //update the current position
-        mIniPos = mLastPos;     //set the first initial playback position
-        mPlayHead = 0;          //reset the mAudioBuffer playhead
-    }
-    else{
-        mCurrentPos = mTimeInSec;
-    }
+    bool isPlaying = false;
+    int64 timeInSamples = 0;
     
+    //bars mode only follows the tempo the host reports for this block
+    mScheduler.clearHostPosition();
     
-    //if the current position hits the next playback point
-    if(mLastPos + mPeriod < mCurrentPos && mIsMoving)
+    if(AudioPlayHead* playHead = getPlayHead())
     {
-        mIsPlay = true;         //start playing the sample
-        mLastPos = mCurrentPos; //set the last playback position to the current position
-        mPlayHead = 0;          //reset the mAudioBuffer playhead
-    }
-    /*
-     if the current position is within the playback length
-     and it's not the first playback triggering at the beginning or moving the tranpost position
-     */
-    else if((mCurrentPos - mLastPos) < mDuration && mLastPos > 0.0001 && mLastPos > mIniPos && mIsMoving)
-    {
-        mIsPlay = true; // keep playing the sample
-    }
-    else
-    {
-        mIsPlay = false;
+        if(auto positionInfo = playHead->getPosition())
+        {
+            isPlaying = positionInfo->getIsPlaying();
+            
+            if(auto samples = positionInfo->getTimeInSamples())
+                timeInSamples = *samples;
+            else if(auto seconds = positionInfo->getTimeInSeconds())
+                timeInSamples = static_cast<int64>(std::llround(*seconds * getSampleRate()));
+            
+            mScheduler.setHostPosition(timeInSamples, *positionInfo);
+        }
     }
     
     
@@ -228,6 +244,24 @@ void RepeatorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     else
         mGain = pow(10., mGain/20.);
     
+    //gain changes ramp per sample instead of stepping at the block boundary
+    const int numSamples = buffer.getNumSamples();
+    const bool fitsScratch = numSamples <= mGainScratch.getNumSamples();
+    
+    mSmoothedGain.setTargetValue(mGain);
+    
+    const bool isGainRamping = mSmoothedGain.isSmoothing() && fitsScratch;
+    if(isGainRamping)
+    {
+        auto* ramp = mGainScratch.getWritePointer(rampChannel);
+        for (int i=0; i<numSamples; i++)
+            ramp[i] = mSmoothedGain.getNextValue();
+    }
+    else
+    {
+        mSmoothedGain.setCurrentAndTargetValue(mGain);
+    }
+    
     
     // In case we have more outputs than inputs, this code clears any output
     // channels that didn't contain input data, (because these aren't
@@ -236,62 +270,133 @@ void RepeatorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     // when they first compile a plugin, but obviously you don't need to keep
     // this code if your algorithm always overwrites all the output channels.
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-
-    // This is the place where you'd normally do the guts of your plugin's
-    // audio processing...
-    // Make sure to reset the state if your inner loop is processing
-    // the samples and the outer loop is handling the channels.
-    // Alternatively, you can process the samples with the channels
-    // interleaved by keeping the same state.
+        buffer.clear (i, 0, numSamples);
+    
+    
+    const auto noiseColour = static_cast<NoiseGenerator::Colour>(static_cast<int>(mAPVTS.getRawParameterValue("NOISE")->load()));
     
+    const PlaybackMode mode = mMode.load();
     
-    //select "silence"
-    if(mSelection==mArrSelect.indexOf(TRANS("silence")) && mIsPlay)
+    const bool isSilence = mode == PlaybackMode::silence;
+    const bool isNoise = mode == PlaybackMode::noise;
+    const bool isSample = mode == PlaybackMode::sample && sample != nullptr && mSampleScratch.getNumSamples() > 0
+                       && (std::is_same_v<SampleType, float> || mSampleScratchDouble.getNumSamples() >= mSampleScratch.getNumSamples());
+    
+    //routes follow the channel count of whatever sample is playing
+    const int numSourceChannels = isSample ? jmin(sample->getNumChannels(), mSampleScratch.getNumChannels()) : 0;
+    if(isSample)
     {
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        mChannelMatrix.update(numSourceChannels);
+        sample->setNonRealtime(isNonRealtime());
+    }
+    
+    //stopped or switched away, the sample starts over wherever playback picks up
+    if(! isSample || ! isPlaying)
+        mNextSamplePosition = -1;
+    
+    //a sample plays for exactly its length, silence and noise for builtInDurationInSec
+    const int64 durationInSamples = isSample ? static_cast<int64>(sample->getLengthInSamples())
+                                             : static_cast<int64>(std::llround(builtInDurationInSec * getSampleRate()));
+    
+    //a PERIOD of 0, only reachable by automation, means no triggers rather than one every sample
+    mScheduler.setPeriod(static_cast<int64>(std::llround(mPeriod * getSampleRate())));
+    mScheduler.setDuration(durationInSamples);
+    
+    mScheduler.process(timeInSamples, numSamples, isPlaying,
+                       [&] (int startInBlock, int numSegment, int64 positionInTrigger, int64 triggerLength)
+    {
+        //fade in and out at the trigger edges so neither end clicks, also where the next trigger cuts it off
+        const bool isFading = fitsScratch && MixKernels::needsEdgeFade(numSegment, positionInTrigger, triggerLength, mFadeLength);
+        auto* envelope = mGainScratch.getWritePointer(envelopeChannel);
+        
+        if(isFading)
+            MixKernels::fillEdgeFade(envelope, numSegment, positionInTrigger, triggerLength, mFadeLength);
+        
+        //one gain per sample only when ramping or fading, otherwise a constant
+        const float* gains = nullptr;
+        const float gain = mSmoothedGain.getCurrentValue();
+        
+        if(isGainRamping || isFading)
         {
-            auto* channelData = buffer.getWritePointer(channel);
-
-            for (int i=0; i<buffer.getNumSamples(); i++)
+            auto* segmentGains = mGainScratch.getWritePointer(segmentGainChannel);
+            
+            if(isGainRamping)
+                FloatVectorOperations::copy(segmentGains, mGainScratch.getReadPointer(rampChannel, startInBlock), numSegment);
+            else
+                FloatVectorOperations::fill(segmentGains, gain, numSegment);
+            
+            if(isFading)
+                FloatVectorOperations::multiply(segmentGains, envelope, numSegment);
+            
+            gains = segmentGains;
+        }
+        
+        //select "silence"
+        if(isSilence)
+        {
+            for (int channel = 0; channel < totalNumInputChannels; ++channel)
             {
-                channelData[i] = 0.;
+                auto* channelData = buffer.getWritePointer(channel, startInBlock);
+                
+                if(isFading)
+                    MixKernels::duck(channelData, envelope, mGainScratch.getWritePointer(segmentGainChannel), numSegment);
+                else
+                    FloatVectorOperations::clear(channelData, numSegment);
             }
         }
-    }
-    //select "noise"
-    else if(mSelection==mArrSelect.indexOf(TRANS("noise")) && mIsPlay)
-    {
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        //select "noise"
+        else if(isNoise)
         {
-            auto* channelData = buffer.getWritePointer(channel);
-
-            for (int i=0; i<buffer.getNumSamples(); i++)
+            if(positionInTrigger == 0)
+                mNoise.reset();
+            
+            for (int channel = 0; channel < totalNumInputChannels; ++channel)
             {
-                channelData[i] += mGain * (-0.09f + static_cast <float> (rand()) /( static_cast <float> (RAND_MAX/(0.18f))));;
+                auto* channelData = buffer.getWritePointer(channel, startInBlock);
+                
+                if(gains != nullptr)
+                    mNoise.addNoise(channelData, numSegment, channel, timeInSamples + startInBlock, noiseColour, gains);
+                else
+                    mNoise.addNoise(channelData, numSegment, channel, timeInSamples + startInBlock, noiseColour, gain);
             }
         }
-    }
-    //selection is beyond "noise", play the sample
-    else if(mSelection>=mArrSelect.indexOf(TRANS("beep")) && mIsPlay && !mAudioBuffer.hasBeenCleared())
-    {
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        //selection is beyond "noise", play the sample
+        else if(isSample)
         {
-            auto* channelData = buffer.getWritePointer(channel);
-
-            for (int i=0; i<buffer.getNumSamples(); i++)
+            //a trigger, or playback that doesn't continue the last segment, like a start or jump into a trigger
+            if(positionInTrigger == 0 || positionInTrigger != mNextSamplePosition)
+                sample->rewind(static_cast<int>(positionInTrigger));
+            
+            mNextSamplePosition = positionInTrigger + numSegment;
+            
+            //the scratch buffer is sized in prepareToPlay, bigger segments are read in pieces
+            for (int offset = 0; offset < numSegment; offset += mSampleScratch.getNumSamples())
             {
-                channelData[i] += mGain * 
-                mAudioBuffer.getSample(channel, i+mPlayHead);
+                const int numToRead = jmin(mSampleScratch.getNumSamples(), numSegment - offset);
+                const int position = static_cast<int>(positionInTrigger) + offset;
+                const float* segmentGains = gains != nullptr ? gains + offset : nullptr;
+                
+                //double samples are read as double, float ones go through the float scratch
+                if constexpr (std::is_same_v<SampleType, double>)
+                {
+                    sample->readSamples(mSampleScratchDouble.getArrayOfWritePointers(), mSampleScratch.getArrayOfWritePointers(),
+                                        numSourceChannels, position, numToRead);
+                    
+                    mChannelMatrix.mix(buffer.getArrayOfWritePointers(), startInBlock + offset,
+                                       mSampleScratchDouble.getArrayOfReadPointers(), segmentGains, gain, numToRead);
+                }
+                else
+                {
+                    sample->readSamples(mSampleScratch.getArrayOfWritePointers(), numSourceChannels, position, numToRead);
+                    
+                    mChannelMatrix.mix(buffer.getArrayOfWritePointers(), startInBlock + offset,
+                                       mSampleScratch.getArrayOfReadPointers(), segmentGains, gain, numToRead);
+                }
             }
         }
-        
-        mPlayHead += buffer.getNumSamples();
-    }
-    else
-    {
-    }
+    });
     
+    mLoadMeter.addBlock(static_cast<int>(mode), numSamples, Time::getHighResolutionTicks() - startTicks);
 }
 
 //==============================================================================
@@ -317,90 +422,99 @@ void RepeatorAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
     
+    PluginState state;
     
-    static Identifier otherStateID("otherStateID");
-    ValueTree otherStateVT(otherStateID); //initial ValueTree
-    
+    for(auto* parameter : getParameters())
+        if(auto* ranged = dynamic_cast<RangedAudioParameter*>(parameter))
+            state.parameters.push_back({ ranged->paramID, ranged->convertFrom0to1(ranged->getValue()) });
     
-    static Identifier selectionID("selectionInt"); //initial Identifier
-    otherStateVT.setProperty(selectionID, var(mSelection), nullptr);
+    state.selection = mSelection;
+    state.language = mLanguage;
+    state.paths = mArrPath; //the menu names are rebuilt from the paths
+    state.channelMatrix = mChannelMatrix.getCustomMatrix();
+    state.streamingThresholdInSec = mSampleLoader.getStreamingThreshold();
+    state.compressedBitDepth = mSampleLoader.getCompressedBitDepth();
+    state.noiseSeed = mNoise.getSeed();
     
-    static Identifier languageID("languageInt"); //initial Identifier
-    otherStateVT.setProperty(languageID, var(mLanguage), nullptr);
+    const auto schedule = mScheduler.getSchedule();
+    state.triggerMode = static_cast<int>(schedule->mode);
+    state.triggerJitter = schedule->jitter;
+    state.triggerSeed = schedule->seed;
+    state.triggerTimesInSec = schedule->timesInSec;
+    state.triggerBars = schedule->bars;
     
-    static Identifier arrSelectID("selectionStringArray"); //initial Identifier
-    otherStateVT.setProperty(arrSelectID, var(mArrSelect), nullptr);
-    
-    static Identifier arrPathID("pathStringArray"); //initial Identifier
-    otherStateVT.setProperty(arrPathID, var(mArrPath), nullptr);
-
-    
-    mAPVTS.state.addChild(otherStateVT, 0, nullptr); //add child node to valuetree
-    
-    
-    
-    MemoryOutputStream stream(destData, false);
-    mAPVTS.state.writeToStream (stream);
+    //only the sample of the current selection is worth carrying
+    state.embedSample = mSampleLoader.isEmbedding();
+    const int idx = mSelection - 1 - mArrSelectOriginal.indexOf("beep");
     
+    if(auto embedded = mSampleLoader.getEmbeddedSample())
+    {
+        if(state.embedSample && isPositiveAndBelow(idx, mArrPath.size()) && embedded->getPath() == mArrPath[idx])
+        {
+            state.embeddedPath = embedded->getPath();
+            state.embeddedHash = embedded->getHash();
+            state.embeddedData = embedded->getData();
+        }
+    }
     
+    destData.reset();
+    state.write(destData);
 }
 
 void RepeatorAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
-    auto tree = ValueTree::readFromData(data, size_t(sizeInBytes));
-        if (tree.isValid() == false)
-            return; //end the function
-
-    mAPVTS.replaceState (tree);
+    PluginState state;
+    if(sizeInBytes <= 0 || ! state.read(data, static_cast<size_t>(sizeInBytes)))
+        return; //end the function
     
+    for(auto& parameter : state.parameters)
+        if(auto* ranged = mAPVTS.getParameter(parameter.id))
+            ranged->setValueNotifyingHost(ranged->convertTo0to1(parameter.value));
     
-    static Identifier otherStateID("otherStateID");
-    ValueTree otherStateVT = mAPVTS.state.getChildWithName(otherStateID);
+    //keep the built in names in the current language and the "load..." item, then one name per file
+    const String loadItem = mArrSelect[mArrSelect.size()-1];
+    mArrSelect.removeRange(mArrSelectOriginal.size()-1, mArrSelect.size());
     
+    mArrPath = state.paths;
+    for(auto& path : mArrPath)
+        mArrSelect.add(File(path).getFileName());
     
-    ///*
-    static Identifier arrSelectID("selectionStringArray");
-    var varArrSelect = otherStateVT[arrSelectID];
-    //try static cast when everything is fixed
-    if (!varArrSelect.isVoid())
-    {
-        mArrSelect.clear();
-        for (int i=0; i<varArrSelect.size(); i++)
-        {
-            mArrSelect.add(varArrSelect[i]);
-        }
-    }
-    
-    static Identifier arrPathID("pathStringArray");
-    var varArrPath = otherStateVT[arrPathID];
-    //try static cast when everything is fixed
-    if (!varArrPath.isVoid())
-    {
-        mArrPath.clear();
-        for (int i=0; i<varArrPath.size(); i++)
-        {
-            mArrPath.add(varArrPath[i]);
-        }
-    }
+    mArrSelect.add(loadItem);
     
+    mLanguage = state.language;
+    setSelection(state.selection);
     
+    if(state.streamingThresholdInSec)
+        mSampleLoader.setStreamingThreshold(*state.streamingThresholdInSec);
     
-    static Identifier languageID("languageInt");
-    mLanguage = otherStateVT[languageID];
+    if(state.compressedBitDepth)
+        mSampleLoader.setCompressedBitDepth(*state.compressedBitDepth);
     
-    static Identifier selectionID("selectionInt");
-    mSelection = otherStateVT[selectionID];
+    mChannelMatrix.setCustomMatrix(state.channelMatrix);
     
+    if(state.noiseSeed)
+        mNoise.setSeed(*state.noiseSeed);
     
-    if(mSelection > mArrSelectOriginal.indexOf("beep"))
-        LoadExistingFile();
-    else if (mSelection == mArrSelectOriginal.indexOf("beep"))
-        LoadBeep();
+    if(state.triggerMode == static_cast<int>(TriggerScheduler::Mode::jitter))
+        mScheduler.setJitter(state.triggerJitter, state.triggerSeed);
+    else if(state.triggerMode == static_cast<int>(TriggerScheduler::Mode::list))
+        mScheduler.setList(std::move(state.triggerTimesInSec));
+    else if(state.triggerMode == static_cast<int>(TriggerScheduler::Mode::bars))
+        mScheduler.setBars(state.triggerBars);
+    else
+        mScheduler.setGrid();
     
+    mSampleLoader.setEmbedding(state.embedSample);
+    if(! state.embeddedData.isEmpty())
+        mSampleLoader.setEmbeddedSample(state.embeddedPath, std::move(state.embeddedData), state.embeddedHash);
     
     
+    //only queued here, restoring returns straight away
+    //before prepareToPlay the rate is unknown, prepareToPlay queues it then
+    if(getSampleRate() > 0.)
+        reloadSample();
 }
 
 //==============================================================================
@@ -430,30 +544,32 @@ AudioProcessorValueTreeState::ParameterLayout RepeatorAudioProcessor::createPara
     
     params.add(std::make_unique<AudioParameterInt> (ParameterID{"PERIOD", 1}, "Period", 0, 60, 15));
     
+    params.add(std::make_unique<AudioParameterChoice> (ParameterID{"NOISE", 1}, "Noise", StringArray{"White", "Pink", "Brown"}, 0));
+    
     return params;
 }
 
 
 //==============================================================================
-void RepeatorAudioProcessor::loadFile(AudioFormatReader* reader)
+void RepeatorAudioProcessor::setSelection(int selection)
 {
-    mDuration = reader->lengthInSamples / reader->sampleRate;
-    
-    if(reader->sampleRate != getSampleRate())
-    {
-        reSample(reader);
-    }
+    mSelection = selection;
+    
+    //mArrSelectOriginal is never translated, so the indices are stable
+    if(selection == mArrSelectOriginal.indexOf("silence"))
+        mMode = PlaybackMode::silence;
+    else if(selection == mArrSelectOriginal.indexOf("noise"))
+        mMode = PlaybackMode::noise;
+    else if(selection >= mArrSelectOriginal.indexOf("beep"))
+        mMode = PlaybackMode::sample;
     else
-    {
-        mIsResampled = false;
-        int newLengthInSamples = juce::roundToInt(reader->lengthInSamples) + 4096;
-        mAudioBuffer.clear();
-        mAudioBuffer.setSize(getTotalNumInputChannels(), newLengthInSamples);
-        reader->read(&mAudioBuffer, 0, newLengthInSamples-4096, 0, false, false);
-    }
-    
-    delete reader;
-    mPlayHead = 0;
+        mMode = PlaybackMode::bypass;
+}
+
+
+void RepeatorAudioProcessor::loadFile(const File& file)
+{
+    mSampleLoader.loadFile(file, getSampleRate(), fileChannels);
 }
 
 
@@ -464,56 +580,52 @@ void RepeatorAudioProcessor::LoadExistingFile()
     {
         const File file(mArrPath.getReference(idx));
         
-        AudioFormatReader* reader = mFormatManager.createReaderFor(file);
-        
-        if(reader!=nullptr)
+        //an embedded copy is loaded from memory, whether or not the file is still there
+        if(mSampleLoader.hasEmbeddedSampleFor(file) || file.existsAsFile())
         {
             mFileName = file.getFileName();
-            loadFile(reader);
+            loadFile(file);
         }
     }
 }
 
 
-void RepeatorAudioProcessor::LoadBeep()
+void RepeatorAudioProcessor::setEmbedSample(bool shouldEmbed)
 {
-    InputStream* inputStream = new MemoryInputStream (BinaryData::beep_ogg, BinaryData::beep_oggSize, false);
-    OggVorbisAudioFormat oggAudioFormat;
-    AudioFormatReader* reader = oggAudioFormat.createReaderFor(inputStream, false);
-
-    if (reader != nullptr)
-    {
-        loadFile(reader);
-    }
+    mSampleLoader.setEmbedding(shouldEmbed);
+    
+    //reading the current file again is what embeds it
+    if(shouldEmbed)
+        reloadSample();
 }
 
-//==============================================================================
-void RepeatorAudioProcessor::reSample(AudioFormatReader* reader)
-{
-    double reSampleRatio = reader->sampleRate / getSampleRate();
-    
-    //4096: leave some empty samples for the last processing block access
-    int newLengthInSamples = juce::roundToInt(reader->lengthInSamples / reSampleRatio + 4096);
-    
-    mIsResampled = true;
-    
-    AudioFormatReaderSource readerSource(reader, false);
-    ResamplingAudioSource resamplingSource(&readerSource, false, getTotalNumInputChannels());
 
-    resamplingSource.setResamplingRatio (reSampleRatio);
-    resamplingSource.prepareToPlay (newLengthInSamples, getSampleRate());
+void RepeatorAudioProcessor::setCompressedBitDepth(int bitDepth)
+{
+    if(bitDepth == mSampleLoader.getCompressedBitDepth())
+        return;
     
-    mAudioBuffer.clear();
-    mAudioBuffer.setSize(getTotalNumInputChannels(), newLengthInSamples);
-    AudioSourceChannelInfo info(&mAudioBuffer, 0, newLengthInSamples);
-
-    resamplingSource.getNextAudioBlock(info);
-
-    resamplingSource.releaseResources();
+    mSampleLoader.setCompressedBitDepth(bitDepth);
+    reloadSample();
 }
 
 
+void RepeatorAudioProcessor::LoadBeep()
+{
+    mSampleLoader.loadBeep(getSampleRate(), fileChannels);
+}
 
 
+void RepeatorAudioProcessor::reloadSample()
+{
+    if(mSelection > mArrSelectOriginal.indexOf("beep"))
+        LoadExistingFile();
+    else if (mSelection == mArrSelectOriginal.indexOf("beep"))
+        LoadBeep();
+}
 
 
+bool RepeatorAudioProcessor::waitForSampleLoad(int timeoutMs)
+{
+    return mSampleLoader.waitUntilIdle(timeoutMs);
+}
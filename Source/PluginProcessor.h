@@ -9,8 +9,28 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "SampleLoader.h"
+#include "TriggerScheduler.h"
+#include "NoiseGenerator.h"
+#include "ChannelMatrix.h"
+#include "RealtimeCheck.h"
+#include "LoadMeter.h"
+#include "PluginState.h"
 
 
+//==============================================================================
+/**
+ What processBlock plays during a trigger. Written by the UI, read lock-free
+ by the audio thread, so no menu strings or translations reach processBlock.
+*/
+enum class PlaybackMode
+{
+    bypass = 0,
+    silence,
+    noise,
+    sample  //whatever SampleLoader last published, beep or a file
+};
+
 
 //==============================================================================
 /**
@@ -31,6 +51,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -66,23 +88,41 @@ public:
     
     //some of these can be private
     float mPeriod = 15.f;
-    float mIniPos = 0.f;
-    float mLastPos = 0.f;
-    float mCurrentPos = 0.f;
-    float mDuration = 1.f;
-    bool mIsPlay = false;
     float mGain {1.0};
     
-    //parameters for sample playback
-    int mPlayHead = 0;
-    float mBlockInSec = 0.f;
-    float mTimeInSec = 0.f;
-    
     //==============================================================================    
-    void loadFile(AudioFormatReader* reader);
+    //these only queue the decode, the sample is swapped in by processBlock when ready
+    void loadFile(const File& file);
     void LoadExistingFile();
     void LoadBeep();
     
+    //queue the current selection again, e.g. after the sample rate changed
+    void reloadSample();
+    
+    //keeps the selected file inside the saved state, so sessions restore without it
+    void setEmbedSample(bool shouldEmbed);
+    bool isEmbeddingSample() const noexcept { return mSampleLoader.isEmbedding(); }
+    
+    //16 or 24 keeps decoded samples quantised to 16/24 bits, then losslessly coded, 0 as float, the current sample is loaded again
+    void setCompressedBitDepth(int bitDepth);
+    
+    //blocks until queued loads are decoded, for offline use only
+    bool waitForSampleLoad(int timeoutMs);
+    bool hasLoadedSample() const noexcept { return mSampleLoader.hasLatestSample(); }
+    
+    //the decode workers shared by every instance, with the progress of a session load
+    SampleLoaderPool& getSampleLoaderPool() noexcept { return mSampleLoader.getPool(); }
+    
+    //rows are output channels, columns sample channels, e.g. "1 0; 0 1; 0.5 0.5", empty for automatic
+    void setChannelMatrix(const String& matrix) { mChannelMatrix.setCustomMatrix(matrix); }
+    String getChannelMatrix() const { return mChannelMatrix.getCustomMatrix(); }
+    
+    //where the triggers go: the PERIOD grid, the grid with seeded jitter, a list of times in seconds, or every few bars
+    TriggerScheduler& getTriggerScheduler() noexcept { return mScheduler; }
+    
+    //the cost of every processBlock, per PlaybackMode, read by the editor
+    LoadMeter& getLoadMeter() noexcept { return mLoadMeter; }
+    
     std::unique_ptr<FileChooser> mChooser;
     AudioFormatManager mFormatManager;
     
@@ -92,6 +132,14 @@ public:
     
     int mSelection = 0;
     
+    //message thread: changes mSelection and publishes the matching mode
+    void setSelection(int selection);
+    
+    std::atomic<PlaybackMode> mMode { PlaybackMode::bypass };
+    
+    //silence and noise last this long on every trigger
+    static constexpr float builtInDurationInSec = 1.f;
+    
     String mFileName;
     
     //==============================================================================
@@ -110,16 +158,39 @@ private:
     
     
     //==============================================================================
-    void reSample(AudioFormatReader* reader);
-    AudioBuffer<float> mAudioBuffer;
-    bool mIsResampled = false;
+    SampleLoader mSampleLoader { mFormatManager };
+    AudioBuffer<float> mSampleScratch;
+    AudioBuffer<double> mSampleScratchDouble;
+    ChannelMatrix mChannelMatrix;
+    
+    //modes in PlaybackMode order
+    LoadMeter mLoadMeter { StringArray { "bypass", "silence", "noise", "sample" } };
+    
+    //both processBlock overloads, written once for float and double
+    template<typename SampleType>
+    void processSamples (juce::AudioBuffer<SampleType>& buffer);
+    
+    //samples are loaded with the channels of their file, the matrix maps them onto the bus
+    static constexpr int fileChannels = 0;
     
     //==============================================================================
     AudioProcessorValueTreeState::ParameterLayout createParameters();
     
     
     //==============================================================================
-    bool mIsMoving; //is audio running
+    TriggerScheduler mScheduler;
+    NoiseGenerator mNoise;
+    
+    //where the sample continues if the next segment follows the last one, -1 when it has to rewind
+    int64 mNextSamplePosition = -1;
+    
+    //==============================================================================
+    SmoothedValue<float, ValueSmoothingTypes::Linear> mSmoothedGain { 1.f };
+    int mFadeLength = 0;
+    
+    //per-sample gains for the current block
+    enum { rampChannel = 0, segmentGainChannel, envelopeChannel, numGainScratchChannels };
+    AudioBuffer<float> mGainScratch;
 
     
 };
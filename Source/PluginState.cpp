@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    PluginState.cpp
+    Created: 23 Oct 2026 10:26:51am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+
+
+namespace
+{
+    const char magic[4] = { 'R', 'P', 'T', 'S' };
+    constexpr size_t headerSize = 12;
+
+    //strings longer than this are treated as corrupt rather than allocated
+    constexpr uint32 maxStringSize = 1 << 20;
+
+    void writeString(MemoryOutputStream& stream, const String& text)
+    {
+        const auto utf8 = text.toUTF8();
+        const auto numBytes = static_cast<uint32>(utf8.sizeInBytes() - 1);
+
+        stream.writeInt(static_cast<int>(numBytes));
+        stream.write(utf8.getAddress(), numBytes);
+    }
+
+    bool readString(MemoryInputStream& stream, String& text)
+    {
+        const auto numBytes = static_cast<uint32>(stream.readInt());
+
+        if(numBytes > maxStringSize || static_cast<int64>(numBytes) > stream.getNumBytesRemaining())
+            return false;
+
+        const auto* start = static_cast<const char*>(stream.getData()) + stream.getPosition();
+        text = String::fromUTF8(start, static_cast<int>(numBytes));
+        stream.skipNextBytes(numBytes);
+        return true;
+    }
+}
+
+
+//==============================================================================
+void PluginState::write(MemoryBlock& dest) const
+{
+    MemoryOutputStream stream(dest, false);
+    stream.write(magic, sizeof(magic));
+    stream.writeInt(static_cast<int>(currentVersion));
+    stream.writeInt(0); //the payload size, filled in at the end
+
+    //version 1
+    stream.writeInt(selection);
+    stream.writeInt(language);
+    stream.writeFloat(streamingThresholdInSec.value_or(0.f));
+    stream.writeInt(compressedBitDepth.value_or(0));
+    stream.writeInt(static_cast<int>(noiseSeed.value_or(0)));
+
+    stream.writeInt(static_cast<int>(parameters.size()));
+    for(auto& parameter : parameters)
+    {
+        writeString(stream, parameter.id);
+        stream.writeFloat(parameter.value);
+    }
+
+    writeString(stream, channelMatrix);
+
+    stream.writeInt(paths.size());
+    for(auto& path : paths)
+        writeString(stream, path);
+
+    //version 2
+    stream.writeBool(embedSample);
+    writeString(stream, embeddedPath);
+    writeString(stream, embeddedHash);
+    stream.writeInt64(static_cast<int64>(embeddedData.getSize()));
+    stream.write(embeddedData.getData(), embeddedData.getSize());
+
+    //version 3
+    stream.writeInt(triggerMode);
+    stream.writeFloat(triggerJitter);
+    stream.writeInt(static_cast<int>(triggerSeed));
+    stream.writeInt(static_cast<int>(triggerTimesInSec.size()));
+    for(auto time : triggerTimesInSec)
+        stream.writeDouble(time);
+
+    //version 4
+    stream.writeInt(triggerBars);
+
+    const auto end = stream.getPosition();
+    stream.setPosition(8);
+    stream.writeInt(static_cast<int>(end - static_cast<int64>(headerSize)));
+    stream.setPosition(end);
+}
+
+
+bool PluginState::read(const void* data, size_t sizeInBytes)
+{
+    if(data == nullptr || sizeInBytes == 0)
+        return false;
+
+    if(sizeInBytes >= headerSize && std::memcmp(data, magic, sizeof(magic)) == 0)
+        return readBinary(data, sizeInBytes);
+
+    return readLegacyTree(data, sizeInBytes);
+}
+
+//==============================================================================
+bool PluginState::readBinary(const void* data, size_t sizeInBytes)
+{
+    MemoryInputStream header(data, headerSize, false);
+    header.skipNextBytes(sizeof(magic));
+
+    const auto version = static_cast<uint32>(header.readInt());
+    const auto payloadSize = static_cast<uint32>(header.readInt());
+
+    if(version == 0 || payloadSize > sizeInBytes - headerSize)
+        return false;
+
+    MemoryInputStream stream(static_cast<const char*>(data) + headerSize, payloadSize, false);
+
+    //version 1, later versions only add fields after these
+    selection = stream.readInt();
+    language = stream.readInt();
+    streamingThresholdInSec = stream.readFloat();
+    compressedBitDepth = stream.readInt();
+    noiseSeed = static_cast<uint32>(stream.readInt());
+
+    const int numParameters = stream.readInt();
+    if(numParameters < 0 || numParameters > stream.getNumBytesRemaining() / 8)
+        return false;
+
+    parameters.clear();
+    for(int i = 0; i < numParameters; i++)
+    {
+        Parameter parameter;
+        if(! readString(stream, parameter.id))
+            return false;
+
+        parameter.value = stream.readFloat();
+        parameters.push_back(parameter);
+    }
+
+    if(! readString(stream, channelMatrix))
+        return false;
+
+    const int numPaths = stream.readInt();
+    if(numPaths < 0 || numPaths > stream.getNumBytesRemaining() / 4)
+        return false;
+
+    paths.clearQuick();
+    for(int i = 0; i < numPaths; i++)
+    {
+        String path;
+        if(! readString(stream, path))
+            return false;
+
+        paths.add(path);
+    }
+
+    if(version < 2)
+        return true;
+
+    embedSample = stream.readBool();
+    if(! readString(stream, embeddedPath) || ! readString(stream, embeddedHash))
+        return false;
+
+    const int64 embeddedSize = stream.readInt64();
+    if(embeddedSize < 0 || embeddedSize > stream.getNumBytesRemaining())
+        return false;
+
+    embeddedData.replaceAll(static_cast<const char*>(stream.getData()) + stream.getPosition(), static_cast<size_t>(embeddedSize));
+    stream.skipNextBytes(embeddedSize);
+
+    if(version < 3)
+        return true;
+
+    triggerMode = stream.readInt();
+    triggerJitter = stream.readFloat();
+    triggerSeed = static_cast<uint32>(stream.readInt());
+
+    const int numTimes = stream.readInt();
+    if(numTimes < 0 || numTimes > stream.getNumBytesRemaining() / 8)
+        return false;
+
+    triggerTimesInSec.resize(static_cast<size_t>(numTimes));
+    for(auto& time : triggerTimesInSec)
+        time = stream.readDouble();
+
+    if(version < 4)
+        return true;
+
+    triggerBars = stream.readInt();
+    return true;
+}
+
+
+bool PluginState::readLegacyTree(const void* data, size_t sizeInBytes)
+{
+    const auto tree = ValueTree::readFromData(data, sizeInBytes);
+    if(! tree.isValid())
+        return false;
+
+    //the parameters as AudioProcessorValueTreeState writes them
+    parameters.clear();
+    for(const auto& child : tree)
+        if(child.hasProperty("id") && child.hasProperty("value"))
+            parameters.push_back({ child["id"].toString(), static_cast<float>(child["value"]) });
+
+    //every save added another child at the front, so the first one is the newest
+    const auto other = tree.getChildWithName("otherStateID");
+
+    selection = other["selectionInt"];
+    language = other["languageInt"];
+    channelMatrix = other["channelMatrixString"].toString();
+
+    paths.clearQuick();
+    if(auto* array = other["pathStringArray"].getArray())
+        for(auto& path : *array)
+            paths.add(path.toString());
+
+    if(other.hasProperty("streamingThresholdSec"))
+        streamingThresholdInSec = static_cast<float>(other["streamingThresholdSec"]);
+
+    if(other.hasProperty("compressedBitDepthInt"))
+        compressedBitDepth = static_cast<int>(other["compressedBitDepthInt"]);
+
+    if(other.hasProperty("noiseSeedInt"))
+        noiseSeed = static_cast<uint32>(static_cast<int>(other["noiseSeedInt"]));
+
+    return true;
+}
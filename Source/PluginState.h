@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    PluginState.h
+    Created: 23 Oct 2026 10:26:51am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+//==============================================================================
+/**
+ Everything getStateInformation saves, in a compact binary layout.
+
+ The blob is a 12 byte header, "RPTS", the format version and the payload size,
+ all little endian, followed by the fields of every version in order. A new
+ version only ever appends fields, so older builds read the fields they know
+ and skip the rest, and newer builds fill in defaults for what an older blob
+ doesn't have. Strings are a 32-bit byte count followed by UTF-8.
+
+ The size only depends on the settings and the loaded paths, never on how
+ often the host saved. Blobs written before this format, ValueTree streams of
+ the parameters with an "otherStateID" child, are still read.
+*/
+struct PluginState
+{
+    static constexpr uint32 currentVersion = 4;
+
+    struct Parameter
+    {
+        String id;
+        float value; //in the parameter's own range, not 0 to 1
+    };
+
+    //==============================================================================
+    //version 1
+    int selection = 0;
+    int language = 0;
+    std::vector<Parameter> parameters;
+    StringArray paths;
+    String channelMatrix;
+
+    //absent in the oldest ValueTree states
+    std::optional<float> streamingThresholdInSec;
+    std::optional<int> compressedBitDepth;
+    std::optional<uint32> noiseSeed;
+
+    //version 2, the sample kept inside the state, see EmbeddedSample
+    bool embedSample = false;
+    String embeddedPath;
+    String embeddedHash;
+    MemoryBlock embeddedData;
+
+    //version 3, the trigger timeline, see TriggerScheduler
+    int triggerMode = 0;
+    float triggerJitter = 0.f;
+    uint32 triggerSeed = 0;
+    std::vector<double> triggerTimesInSec;
+
+    //version 4
+    int triggerBars = 1;
+
+    //==============================================================================
+    void write(MemoryBlock& dest) const;
+
+    //reads either format, returns false when the data is neither
+    bool read(const void* data, size_t sizeInBytes);
+
+private:
+    bool readBinary(const void* data, size_t sizeInBytes);
+    bool readLegacyTree(const void* data, size_t sizeInBytes);
+};
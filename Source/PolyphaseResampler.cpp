@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    PolyphaseResampler.cpp
+    Created: 19 Oct 2026 2:12:48pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "PolyphaseResampler.h"
+
+
+namespace
+{
+    //zeroth order modified Bessel function, for the Kaiser window
+    double besselI0(double x)
+    {
+        double sum = 1., term = 1.;
+
+        for(int k = 1; k < 32; k++)
+        {
+            term *= (x / (2. * k)) * (x / (2. * k));
+            sum += term;
+        }
+
+        return sum;
+    }
+}
+
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler(double sourceRate, double targetRate, int numChannels)
+    : mStep(sourceRate / targetRate)
+{
+    jassert(sourceRate > 0. && targetRate > 0.);
+
+    //when downsampling the cutoff follows the target Nyquist and the filter gets longer to match
+    const double bandwidth = jmin(1., targetRate / sourceRate);
+    const double cutoff = 0.95 * bandwidth;
+    const double beta = 8.;
+
+    mHalfLength = jlimit(16, 256, static_cast<int>(std::ceil(16. / bandwidth)));
+    mHalfLength = (mHalfLength + 3) & ~3; //whole vectors of taps
+    mNumTaps = 2 * mHalfLength;
+
+    //one row more than there are phases so the last phase has a neighbour to interpolate to
+    HeapBlock<float> rows(static_cast<size_t>((numPhases + 1) * mNumTaps));
+
+    for(int phase = 0; phase <= numPhases; phase++)
+    {
+        float* row = rows + phase * mNumTaps;
+        double sum = 0.;
+
+        for(int tap = 0; tap < mNumTaps; tap++)
+        {
+            const double t = (tap - mHalfLength + 1) - static_cast<double>(phase) / numPhases;
+            const double x = t / mHalfLength;
+
+            double value = 0.;
+            if(std::abs(x) < 1.)
+            {
+                const double sinc = t == 0. ? 1. : std::sin(MathConstants<double>::pi * cutoff * t) / (MathConstants<double>::pi * cutoff * t);
+                value = cutoff * sinc * besselI0(beta * std::sqrt(1. - x * x)) / besselI0(beta);
+            }
+
+            row[tap] = static_cast<float>(value);
+            sum += value;
+        }
+
+        //unity gain at DC for every phase
+        if(sum != 0.)
+            FloatVectorOperations::multiply(row, static_cast<float>(1. / sum), mNumTaps);
+    }
+
+    mCoefficients.malloc(static_cast<size_t>(numPhases * mNumTaps));
+    mDeltas.malloc(static_cast<size_t>(numPhases * mNumTaps));
+
+    for(int phase = 0; phase < numPhases; phase++)
+    {
+        const float* row = rows + phase * mNumTaps;
+        FloatVectorOperations::copy(mCoefficients + phase * mNumTaps, row, mNumTaps);
+        FloatVectorOperations::subtract(mDeltas + phase * mNumTaps, row + mNumTaps, row, mNumTaps);
+    }
+
+    mInput.setSize(numChannels, mNumTaps + chunkSize);
+    mReadPointers.malloc(static_cast<size_t>(jmax(1, numChannels)));
+
+    setPosition(0);
+}
+
+//==============================================================================
+int64 PolyphaseResampler::getOutputLength(int64 inputLength) const noexcept
+{
+    return static_cast<int64>(std::llround(static_cast<double>(inputLength) / mStep));
+}
+
+
+void PolyphaseResampler::setPosition(int64 outputSample) noexcept
+{
+    mOutputPos = outputSample;
+
+    //forget the window, the next sample refills it from the new position
+    mInputStart = 0;
+    mNumInput = 0;
+}
+
+//==============================================================================
+float PolyphaseResampler::dotProduct(const float* input, const float* coefficients, const float* deltas,
+                                     float fraction, int numTaps) noexcept
+{
+    //eight independent sums map onto vector lanes without reordering any one of them
+    float sums[8] = {};
+
+    for(int tap = 0; tap < numTaps; tap += 8)
+        for(int lane = 0; lane < 8; lane++)
+            sums[lane] += input[tap + lane] * (coefficients[tap + lane] + fraction * deltas[tap + lane]);
+
+    return ((sums[0] + sums[4]) + (sums[1] + sums[5])) + ((sums[2] + sums[6]) + (sums[3] + sums[7]));
+}
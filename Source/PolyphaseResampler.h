@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    PolyphaseResampler.h
+    Created: 19 Oct 2026 2:12:48pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+//==============================================================================
+/**
+ Windowed-sinc sample rate converter.
+
+ Every output sample is computed on its own from the input around its
+ position, with a Kaiser windowed sinc taken from a table of 256 phases and
+ interpolated between neighbouring phases. There is no state besides a small
+ window of input, so the resampler can jump to any output position and still
+ produce exactly the samples a run from the start would have.
+
+ Input is pulled in chunks through a callback,
+ readInput(float* const* dest, int64 inputStart, int numSamples),
+ which must fill numSamples samples of every channel starting at inputStart.
+*/
+class PolyphaseResampler
+{
+public:
+    PolyphaseResampler(double sourceRate, double targetRate, int numChannels);
+
+    //==============================================================================
+    //the number of output samples that cover inputLength input samples
+    int64 getOutputLength(int64 inputLength) const noexcept;
+
+    //the next output sample process() will write
+    void setPosition(int64 outputSample) noexcept;
+    int64 getPosition() const noexcept { return mOutputPos; }
+
+    //==============================================================================
+    template<typename ReadInput>
+    void process(float* const* dest, int numSamples, ReadInput&& readInput)
+    {
+        const int numChannels = mInput.getNumChannels();
+
+        for(int i = 0; i < numSamples; i++)
+        {
+            const double inputPos = static_cast<double>(mOutputPos++) * mStep;
+            const double integral = std::floor(inputPos);
+            const int64 firstTap = static_cast<int64>(integral) - mHalfLength + 1;
+
+            if(firstTap < mInputStart || firstTap + mNumTaps > mInputStart + mNumInput)
+                refill(firstTap, readInput);
+
+            const float phase = static_cast<float>(inputPos - integral) * numPhases;
+            const int phaseIndex = jmin(static_cast<int>(phase), numPhases - 1);
+            const float* coefficients = mCoefficients + phaseIndex * mNumTaps;
+            const float* deltas = mDeltas + phaseIndex * mNumTaps;
+            const int offset = static_cast<int>(firstTap - mInputStart);
+
+            for(int channel = 0; channel < numChannels; channel++)
+                dest[channel][i] = dotProduct(mInput.getReadPointer(channel, offset), coefficients, deltas,
+                                              phase - static_cast<float>(phaseIndex), mNumTaps);
+        }
+    }
+
+private:
+    //==============================================================================
+    static float dotProduct(const float* input, const float* coefficients, const float* deltas,
+                            float fraction, int numTaps) noexcept;
+
+    //moves the window so it starts at firstTap, keeping what it already holds
+    template<typename ReadInput>
+    void refill(int64 firstTap, ReadInput&& readInput)
+    {
+        const int numChannels = mInput.getNumChannels();
+        const int capacity = mInput.getNumSamples();
+        int numKept = 0;
+
+        if(firstTap >= mInputStart && firstTap < mInputStart + mNumInput)
+        {
+            const int shift = static_cast<int>(firstTap - mInputStart);
+            numKept = mNumInput - shift;
+
+            for(int channel = 0; channel < numChannels; channel++)
+                std::memmove(mInput.getWritePointer(channel), mInput.getReadPointer(channel, shift),
+                             sizeof(float) * static_cast<size_t>(numKept));
+        }
+
+        mInputStart = firstTap;
+        mNumInput = capacity;
+
+        //nothing comes before the start of the input
+        int64 readStart = mInputStart + numKept;
+        int done = numKept;
+
+        if(readStart < 0)
+        {
+            const int numSilent = static_cast<int>(jmin(static_cast<int64>(capacity - done), -readStart));
+            for(int channel = 0; channel < numChannels; channel++)
+                FloatVectorOperations::clear(mInput.getWritePointer(channel, done), numSilent);
+
+            done += numSilent;
+            readStart += numSilent;
+        }
+
+        if(done < capacity)
+        {
+            for(int channel = 0; channel < numChannels; channel++)
+                mReadPointers[channel] = mInput.getWritePointer(channel, done);
+
+            readInput(mReadPointers.getData(), readStart, capacity - done);
+        }
+    }
+
+    //==============================================================================
+    static constexpr int numPhases = 256;
+    static constexpr int chunkSize = 4096;
+
+    double mStep = 1.;          //input samples per output sample
+    int mHalfLength = 0;
+    int mNumTaps = 0;
+
+    //numPhases rows of taps, and the difference to the next row for interpolation
+    HeapBlock<float> mCoefficients;
+    HeapBlock<float> mDeltas;
+
+    AudioBuffer<float> mInput;
+    HeapBlock<float*> mReadPointers;
+    int64 mInputStart = 0;
+    int mNumInput = 0;
+    int64 mOutputPos = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
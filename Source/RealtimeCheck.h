@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.h
+    Created: 22 Oct 2026 9:12:06am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef REPEATOR_RT_CHECK
+ #define REPEATOR_RT_CHECK 0
+#endif
+
+
+//==============================================================================
+/**
+ Marks the code that runs on the audio thread, so a checker build can catch
+ allocations, locks and blocking calls made from it.
+
+ With REPEATOR_RT_CHECK=1 a ScopedRealtime raises a per-thread depth, and the
+ interposed malloc, free, pthread_mutex_lock, sleeps and file calls of
+ repeator-rtcheck report every call made while it is above zero, with the
+ call stack. In normal builds ScopedRealtime is empty and costs nothing.
+*/
+namespace RealtimeCheck
+{
+   #if REPEATOR_RT_CHECK
+    inline thread_local int realtimeDepth = 0;
+
+    struct ScopedRealtime
+    {
+        ScopedRealtime() noexcept  { ++realtimeDepth; }
+        ~ScopedRealtime() noexcept { --realtimeDepth; }
+    };
+
+    //the opposite, for code the audio thread is allowed to run blocking, like the checker's own reporting
+    struct ScopedNonRealtime
+    {
+        ScopedNonRealtime() noexcept : mSavedDepth(realtimeDepth) { realtimeDepth = 0; }
+        ~ScopedNonRealtime() noexcept                              { realtimeDepth = mSavedDepth; }
+
+        const int mSavedDepth;
+    };
+
+    inline bool isRealtime() noexcept { return realtimeDepth > 0; }
+
+    //implemented by the checker, violations reported since the start
+    int getNumViolations() noexcept;
+   #else
+    struct ScopedRealtime
+    {
+        ScopedRealtime() noexcept {}
+    };
+
+    struct ScopedNonRealtime
+    {
+        ScopedNonRealtime() noexcept {}
+    };
+
+    constexpr bool isRealtime() noexcept { return false; }
+   #endif
+}
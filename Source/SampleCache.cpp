@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    SampleCache.cpp
+    Created: 19 Oct 2026 4:37:15pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "SampleCache.h"
+#include "MappedSampleData.h"
+
+
+namespace
+{
+    //bump when the decoder or the resampler output changes, old entries then simply age out
+    constexpr int cacheFormatVersion = 1;
+}
+
+
+//==============================================================================
+SampleCache::SampleCache()
+    : SampleCache(getDefaultDirectory())
+{
+}
+
+
+SampleCache::SampleCache(const File& directory, int64 maxSizeInBytes)
+    : mDirectory(directory),
+      mMaxSizeInBytes(maxSizeInBytes)
+{
+}
+
+
+File SampleCache::getDefaultDirectory()
+{
+   #if JUCE_MAC
+    return File::getSpecialLocation(File::userHomeDirectory).getChildFile("Library/Caches/Repeator");
+   #elif JUCE_WINDOWS
+    return File::getSpecialLocation(File::windowsLocalAppData).getChildFile("Voyagers Audio/Repeator/Cache");
+   #else
+    const String xdgCache = SystemStats::getEnvironmentVariable("XDG_CACHE_HOME", {});
+    const File base = xdgCache.isNotEmpty() ? File(xdgCache)
+                                            : File::getSpecialLocation(File::userHomeDirectory).getChildFile(".cache");
+    return base.getChildFile("Repeator");
+   #endif
+}
+
+//==============================================================================
+SampleData::Ptr SampleCache::find(const File& source, double sampleRate, int numChannels)
+{
+    const File entry = getEntryFile(source, sampleRate, numChannels);
+    if(! entry.existsAsFile())
+        return nullptr;
+
+    auto sample = MappedSampleData::create(entry, sampleRate, numChannels);
+
+    //unreadable, probably cut short by a full disk
+    if(sample == nullptr)
+    {
+        entry.deleteFile();
+        return nullptr;
+    }
+
+    entry.setLastModificationTime(Time::getCurrentTime());
+    return sample;
+}
+
+
+void SampleCache::store(const File& source, int numChannels, const ResidentSampleData& sample)
+{
+    const auto& buffer = sample.getBuffer();
+
+    if(buffer.getNumSamples() == 0 || ! mDirectory.createDirectory())
+        return;
+
+    const File entry = getEntryFile(source, sample.getSampleRate(), numChannels);
+    TemporaryFile temporary(entry);
+
+    {
+        std::unique_ptr<FileOutputStream> stream(temporary.getFile().createOutputStream());
+        if(stream == nullptr)
+            return;
+
+        //32-bit WAV is float, which the memory-mapped reader converts without any scaling
+        std::unique_ptr<AudioFormatWriter> writer(WavAudioFormat().createWriterFor(stream.get(), sample.getSampleRate(),
+                                                                                   static_cast<unsigned int>(buffer.getNumChannels()),
+                                                                                   32, {}, 0));
+        if(writer == nullptr)
+            return;
+
+        stream.release(); //the writer owns it now
+
+        if(! writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples()))
+            return;
+    }
+
+    if(temporary.overwriteTargetFileWithTemporary())
+        evict();
+}
+
+
+void SampleCache::setMaxSize(int64 maxSizeInBytes)
+{
+    mMaxSizeInBytes.store(maxSizeInBytes);
+    evict();
+}
+
+//==============================================================================
+File SampleCache::getEntryFile(const File& source, double sampleRate, int numChannels) const
+{
+    String key;
+    key << cacheFormatVersion << "|" << source.getFullPathName() << "|" << source.getSize()
+        << "|" << source.getLastModificationTime().toMilliseconds() << "|" << sampleRate << "|" << numChannels;
+
+    return mDirectory.getChildFile(SHA256(key.toUTF8()).toHexString() + ".wav");
+}
+
+
+void SampleCache::evict()
+{
+    const ScopedLock sl(mEvictLock);
+
+    Array<File> entries = mDirectory.findChildFiles(File::findFiles, false, "*.wav");
+
+    int64 totalSize = 0;
+    for(auto& entry : entries)
+        totalSize += entry.getSize();
+
+    if(totalSize <= mMaxSizeInBytes.load())
+        return;
+
+    //oldest first
+    std::sort(entries.begin(), entries.end(), [] (const File& a, const File& b)
+    {
+        return a.getLastModificationTime() < b.getLastModificationTime();
+    });
+
+    for(auto& entry : entries)
+    {
+        if(totalSize <= mMaxSizeInBytes.load())
+            break;
+
+        const int64 size = entry.getSize();
+
+        //an entry another process still maps can't always be deleted, it goes next time
+        if(entry.deleteFile())
+            totalSize -= size;
+    }
+}
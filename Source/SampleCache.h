@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    SampleCache.h
+    Created: 19 Oct 2026 4:37:15pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+
+
+//==============================================================================
+/**
+ Decoded and resampled samples kept on disk between sessions.
+
+ Every entry is a 32-bit float WAV named after a hash of the source file
+ (path, size and modification time), the target rate and the channel count.
+ A hit is memory-mapped through MappedSampleData, so reopening a project
+ doesn't decode or resample anything. Entries are written to a temporary file
+ and renamed, so other instances and processes never see half an entry.
+
+ The least recently used entries are deleted once the directory grows past
+ the size limit. A hit refreshes the modification time of the entry, which is
+ what the eviction sorts on.
+
+ One cache is shared by every loader in the process.
+*/
+class SampleCache
+{
+public:
+    SampleCache();
+    explicit SampleCache(const File& directory, int64 maxSizeInBytes = defaultMaxSizeInBytes);
+
+    //==============================================================================
+    //returns nullptr on a miss
+    SampleData::Ptr find(const File& source, double sampleRate, int numChannels);
+
+    //writes the entry for the channel count it was requested with, and evicts old ones if the cache grew too big
+    void store(const File& source, int numChannels, const ResidentSampleData& sample);
+
+    void setMaxSize(int64 maxSizeInBytes);
+    int64 getMaxSize() const noexcept { return mMaxSizeInBytes.load(); }
+
+    const File& getDirectory() const noexcept { return mDirectory; }
+
+    //the platform's per-user cache location
+    static File getDefaultDirectory();
+
+    static constexpr int64 defaultMaxSizeInBytes = 2048ll * 1024 * 1024;
+
+private:
+    //==============================================================================
+    File getEntryFile(const File& source, double sampleRate, int numChannels) const;
+    void evict();
+
+    const File mDirectory;
+    std::atomic<int64> mMaxSizeInBytes;
+    CriticalSection mEvictLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleCache)
+};
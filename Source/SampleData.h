@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    SampleData.h
+    Created: 17 Oct 2026 9:41:12am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+//==============================================================================
+/**
+ A sample that is ready to be played at the host sample rate.
+
+ It is built completely on the loader thread and handed over to the audio
+ thread as a whole, so nothing resizes or clears it while processBlock reads it.
+ Subclasses decide where the samples actually live.
+*/
+class SampleData : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<SampleData>;
+
+    ~SampleData() override = default;
+
+    //==============================================================================
+    int getNumChannels() const noexcept { return mNumChannels; }
+    int getLengthInSamples() const noexcept { return mLengthInSamples; }
+
+    //the rate the samples are played at, normally the host rate
+    double getSampleRate() const noexcept { return mSampleRate; }
+
+    //length of the original file, used to decide how long a trigger lasts
+    float getDurationInSec() const noexcept { return mDurationInSec; }
+
+    //==============================================================================
+    /*
+     Audio thread only. Copies numSamples starting at startSample into dest.
+     Channels the sample doesn't have and positions past its end are zeroed.
+     */
+    virtual void readSamples(float* const* dest, int numDestChannels, int startSample, int numSamples) noexcept = 0;
+
+    /*
+     The same for a host running in double precision. By default it reads into
+     the float scratch, which has numDestChannels channels of at least
+     numSamples, and converts. Samples that are held as double override it.
+     */
+    virtual void readSamples(double* const* dest, float* const* scratch, int numDestChannels, int startSample, int numSamples) noexcept
+    {
+        readSamples(scratch, numDestChannels, startSample, numSamples);
+
+        for(int channel = 0; channel < numDestChannels; channel++)
+            for(int i = 0; i < numSamples; i++)
+                dest[channel][i] = static_cast<double>(scratch[channel][i]);
+    }
+
+    /*
+     Audio thread only, called when playback of the sample starts over: at
+     startSample 0 on a trigger, or somewhere inside it when the host starts or
+     jumps into the middle of one.
+     */
+    virtual void rewind(int startSample) noexcept { ignoreUnused(startSample); }
+
+    //audio thread only, true while the host renders offline and waits for every block
+    virtual void setNonRealtime(bool isNonRealtime) noexcept { ignoreUnused(isNonRealtime); }
+
+    //false when the sample keeps playback state, so every instance needs its own
+    virtual bool isShareable() const noexcept { return true; }
+
+protected:
+    SampleData(int numChannels, int lengthInSamples, double sampleRate, float durationInSec)
+        : mNumChannels(numChannels),
+          mLengthInSamples(lengthInSamples),
+          mSampleRate(sampleRate),
+          mDurationInSec(durationInSec)
+    {
+    }
+
+    //clears whatever readSamples could not fill
+    template<typename SampleType>
+    void clearRemainder(SampleType* const* dest, int numDestChannels, int firstChannel, int startOffset, int numSamples) const noexcept
+    {
+        for(int channel = 0; channel < numDestChannels; channel++)
+        {
+            const int from = channel < firstChannel ? startOffset : 0;
+            if(from < numSamples)
+                FloatVectorOperations::clear(dest[channel] + from, numSamples - from);
+        }
+    }
+
+private:
+    //==============================================================================
+    const int mNumChannels;
+    const int mLengthInSamples;
+    const double mSampleRate;
+    const float mDurationInSec;
+
+    JUCE_DECLARE_NON_COPYABLE (SampleData)
+};
+
+
+//==============================================================================
+/**
+ The whole sample decoded into memory as planar floats, or as planar doubles
+ when the host processes in double precision.
+*/
+template<typename StorageType>
+class BasicResidentSampleData : public SampleData
+{
+public:
+    BasicResidentSampleData(AudioBuffer<StorageType>&& buffer, double sampleRate, float durationInSec)
+        : SampleData(buffer.getNumChannels(), buffer.getNumSamples(), sampleRate, durationInSec),
+          mBuffer(std::move(buffer))
+    {
+    }
+
+    const AudioBuffer<StorageType>& getBuffer() const noexcept { return mBuffer; }
+
+    void readSamples(float* const* dest, int numDestChannels, int startSample, int numSamples) noexcept override
+    {
+        copySamples(dest, numDestChannels, startSample, numSamples);
+    }
+
+    void readSamples(double* const* dest, float* const*, int numDestChannels, int startSample, int numSamples) noexcept override
+    {
+        copySamples(dest, numDestChannels, startSample, numSamples);
+    }
+
+private:
+    template<typename SampleType>
+    void copySamples(SampleType* const* dest, int numDestChannels, int startSample, int numSamples) const noexcept
+    {
+        const int numToCopy = jlimit(0, numSamples, getLengthInSamples() - startSample);
+        const int numToCopyChannels = numToCopy > 0 ? jmin(numDestChannels, getNumChannels()) : 0;
+
+        for(int channel = 0; channel < numToCopyChannels; channel++)
+        {
+            const StorageType* source = mBuffer.getReadPointer(channel, startSample);
+
+            if constexpr (std::is_same_v<SampleType, StorageType>)
+                FloatVectorOperations::copy(dest[channel], source, numToCopy);
+            else
+                for(int i = 0; i < numToCopy; i++)
+                    dest[channel][i] = static_cast<SampleType>(source[i]);
+        }
+
+        clearRemainder(dest, numDestChannels, numToCopyChannels, numToCopy, numSamples);
+    }
+
+    const AudioBuffer<StorageType> mBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BasicResidentSampleData)
+};
+
+using ResidentSampleData = BasicResidentSampleData<float>;
+using ResidentDoubleSampleData = BasicResidentSampleData<double>;
@@ -0,0 +1,378 @@
+/*
+  ==============================================================================
+
+    SampleLoader.cpp
+    Created: 17 Oct 2026 9:52:40am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "SampleLoader.h"
+#include "BinaryData.h"
+
+
+namespace
+{
+    //the whole sample read into memory, for cache entries that are kept in another format
+    SampleData::Ptr copyToMemory(SampleData& sample)
+    {
+        AudioBuffer<float> buffer(sample.getNumChannels(), sample.getLengthInSamples());
+        sample.readSamples(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), 0, buffer.getNumSamples());
+
+        return new ResidentSampleData(std::move(buffer), sample.getSampleRate(), sample.getDurationInSec());
+    }
+}
+
+
+//==============================================================================
+SampleLoader::SampleLoader(AudioFormatManager& formatManager)
+    : mFormatManager(formatManager)
+{
+    startTimer(250);
+}
+
+
+SampleLoader::~SampleLoader()
+{
+    stopTimer();
+    mLatestRequest++; //let a running job know its result is no longer wanted
+
+    //the jobs use this loader, so a running one has to finish however long its decode takes
+    mPool->removeJobs(this, -1);
+
+    releaseRetiredSamples();
+
+    if(auto* pending = mPending.exchange(nullptr))
+        pending->decReferenceCount();
+
+    if(mCurrent != nullptr)
+        mCurrent->decReferenceCount();
+
+    mStore->releaseUnused();
+}
+
+//==============================================================================
+void SampleLoader::loadFile(const File& file, double sampleRate, int numChannels)
+{
+    if(hasEmbeddedSampleFor(file))
+    {
+        loadEmbedded(getEmbeddedSample(), sampleRate, numChannels);
+        return;
+    }
+
+    mRequestedSampleRate.store(sampleRate);
+    mRequestedNumChannels.store(numChannels);
+
+    const int bitDepth = mCompressedBitDepth.load();
+    const bool isDoublePrecision = mDoublePrecision.load();
+    mRequestedDoublePrecision.store(isDoublePrecision);
+
+    const float streamingThresholdInSec = mStreamingThresholdInSec.load();
+    const bool shouldEmbed = mEmbedding.load();
+
+    addLoadJob([this, file, sampleRate, numChannels, bitDepth, isDoublePrecision, streamingThresholdInSec, shouldEmbed]
+    {
+        //read once more for the state, the instances sharing the file share this too
+        if(shouldEmbed)
+            setEmbeddedSample(EmbeddedSample::create(*mEmbeddedRegistry, mFormatManager, file));
+
+        //an edited file gets a new entry instead of the copy other instances still play,
+        //and a different threshold one that streams or stays resident as this instance asked
+        const String key = file.getFullPathName() + "@" + String(file.getLastModificationTime().toMilliseconds())
+                         + "#" + String(bitDepth) + (isDoublePrecision ? "d" : "") + "~" + String(streamingThresholdInSec);
+
+        return mStore->getOrCreate(key, sampleRate, numChannels, [&]() -> SampleData::Ptr
+        {
+            //uncompressed files at the host rate are played from the mapped file
+            if(auto mapped = MappedSampleData::create(file, sampleRate, numChannels))
+                return mapped;
+
+            //decoded and resampled by an earlier session, the rate has to be known to look it up
+            const bool useCache = sampleRate > 0.;
+
+            if(useCache)
+            {
+                //a file over the threshold is streamed, even if a session with a higher one cached it
+                auto cached = mCache->find(file, sampleRate, numChannels);
+
+                if(cached != nullptr && cached->getDurationInSec() <= streamingThresholdInSec)
+                {
+                    //the cache holds floats, compressed or double storage is built from them like after a decode
+                    if(bitDepth == 16 || bitDepth == 24 || isDoublePrecision)
+                        return convert(copyToMemory(*cached), bitDepth, isDoublePrecision);
+
+                    return cached;
+                }
+            }
+
+            auto sample = decode(std::unique_ptr<AudioFormatReader>(mFormatManager.createReaderFor(file)), sampleRate, numChannels, streamingThresholdInSec);
+
+            //streamed files are never decoded as a whole, so only resident ones are cached
+            if(useCache)
+                if(auto* resident = dynamic_cast<ResidentSampleData*>(sample.get()))
+                    mCache->store(file, numChannels, *resident);
+
+            return convert(sample, bitDepth, isDoublePrecision);
+        });
+    });
+}
+
+
+void SampleLoader::loadBeep(double sampleRate, int numChannels)
+{
+    mRequestedSampleRate.store(sampleRate);
+    mRequestedNumChannels.store(numChannels);
+
+    const int bitDepth = mCompressedBitDepth.load();
+    const bool isDoublePrecision = mDoublePrecision.load();
+    mRequestedDoublePrecision.store(isDoublePrecision);
+
+    const float streamingThresholdInSec = mStreamingThresholdInSec.load();
+
+    addLoadJob([this, sampleRate, numChannels, bitDepth, isDoublePrecision, streamingThresholdInSec]
+    {
+        const String key = "BinaryData::beep_ogg#" + String(bitDepth) + (isDoublePrecision ? "d" : "") + "~" + String(streamingThresholdInSec);
+
+        return mStore->getOrCreate(key, sampleRate, numChannels, [&]
+        {
+            InputStream* inputStream = new MemoryInputStream (BinaryData::beep_ogg, BinaryData::beep_oggSize, false);
+            OggVorbisAudioFormat oggAudioFormat;
+
+            return convert(decode(std::unique_ptr<AudioFormatReader>(oggAudioFormat.createReaderFor(inputStream, true)), sampleRate, numChannels, streamingThresholdInSec),
+                           bitDepth, isDoublePrecision);
+        });
+    });
+}
+
+
+void SampleLoader::loadEmbedded(EmbeddedSample::Ptr embedded, double sampleRate, int numChannels)
+{
+    mRequestedSampleRate.store(sampleRate);
+    mRequestedNumChannels.store(numChannels);
+
+    const int bitDepth = mCompressedBitDepth.load();
+    const bool isDoublePrecision = mDoublePrecision.load();
+    mRequestedDoublePrecision.store(isDoublePrecision);
+
+    const float streamingThresholdInSec = mStreamingThresholdInSec.load();
+
+    addLoadJob([this, embedded, sampleRate, numChannels, bitDepth, isDoublePrecision, streamingThresholdInSec]
+    {
+        //keyed on the content, so every instance restoring the same data shares one decode
+        const String key = "embedded:" + embedded->getHash() + "#" + String(bitDepth) + (isDoublePrecision ? "d" : "") + "~" + String(streamingThresholdInSec);
+
+        return mStore->getOrCreate(key, sampleRate, numChannels, [&]
+        {
+            return convert(decode(embedded->createReader(mFormatManager), sampleRate, numChannels, streamingThresholdInSec), bitDepth, isDoublePrecision);
+        });
+    });
+}
+
+
+void SampleLoader::addLoadJob(std::function<SampleData::Ptr()> createSample)
+{
+    const int requestId = ++mLatestRequest;
+
+    mPool->addJob(this, [this, createSample, requestId]
+    {
+        //a newer request came in before this one started
+        if(requestId != mLatestRequest.load())
+            return;
+
+        auto sample = createSample();
+
+        //jobs of one loader may run side by side, only the latest one publishes
+        const ScopedLock sl(mPublishLock);
+
+        if(sample != nullptr && requestId == mLatestRequest.load())
+        {
+            publish(sample);
+            mPublishedRequest.store(requestId);
+        }
+    });
+}
+
+//==============================================================================
+void SampleLoader::setEmbedding(bool shouldEmbed)
+{
+    mEmbedding.store(shouldEmbed);
+
+    if(! shouldEmbed)
+        setEmbeddedSample(nullptr);
+}
+
+
+void SampleLoader::setEmbeddedSample(const String& path, MemoryBlock data, const String& hash)
+{
+    setEmbeddedSample(EmbeddedSample::create(*mEmbeddedRegistry, path, std::move(data), hash));
+}
+
+
+void SampleLoader::setEmbeddedSample(EmbeddedSample::Ptr embedded)
+{
+    //the old one is released outside the lock
+    EmbeddedSample::Ptr previous;
+
+    {
+        const SpinLock::ScopedLockType sl(mEmbeddedLock);
+        previous = std::exchange(mEmbedded, embedded);
+    }
+}
+
+
+EmbeddedSample::Ptr SampleLoader::getEmbeddedSample() const
+{
+    const SpinLock::ScopedLockType sl(mEmbeddedLock);
+    return mEmbedded;
+}
+
+
+bool SampleLoader::hasEmbeddedSampleFor(const File& file) const
+{
+    const auto embedded = getEmbeddedSample();
+    return embedded != nullptr && embedded->getPath() == file.getFullPathName();
+}
+
+//==============================================================================
+bool SampleLoader::waitUntilIdle(int timeoutMs)
+{
+    const auto endTime = Time::getMillisecondCounter() + static_cast<uint32>(timeoutMs);
+
+    while(mPool->getNumJobs(this) > 0)
+    {
+        if(Time::getMillisecondCounter() > endTime)
+            return false;
+
+        Thread::sleep(1);
+    }
+
+    return true;
+}
+
+//==============================================================================
+SampleData::Ptr SampleLoader::decode(std::unique_ptr<AudioFormatReader> reader, double sampleRate, int numChannels, float streamingThresholdInSec)
+{
+    if(reader == nullptr || reader->lengthInSamples <= 0)
+        return nullptr;
+
+    if(numChannels <= 0)
+        numChannels = static_cast<int>(reader->numChannels);
+
+    const float durationInSec = static_cast<float>(reader->lengthInSamples / reader->sampleRate);
+
+    //before prepareToPlay the host rate is unknown, keep the file rate
+    if(sampleRate <= 0.)
+        sampleRate = reader->sampleRate;
+
+    //long files keep only their head in memory and stream the rest
+    if(durationInSec > streamingThresholdInSec)
+        return new StreamingSampleData(std::move(reader), sampleRate, numChannels);
+
+    if(reader->sampleRate == sampleRate)
+    {
+        const int lengthInSamples = static_cast<int>(reader->lengthInSamples);
+        AudioBuffer<float> buffer(numChannels, lengthInSamples);
+        reader->read(&buffer, 0, lengthInSamples, 0, true, true);
+
+        return new ResidentSampleData(std::move(buffer), sampleRate, durationInSec);
+    }
+
+    //resampled a chunk at a time straight into the final buffer
+    PolyphaseResampler resampler(reader->sampleRate, sampleRate, numChannels);
+    const int newLengthInSamples = static_cast<int>(resampler.getOutputLength(reader->lengthInSamples));
+
+    AudioBuffer<float> buffer(numChannels, newLengthInSamples);
+
+    resampler.process(buffer.getArrayOfWritePointers(), newLengthInSamples,
+                      [&reader, numChannels] (float* const* dest, int64 inputStart, int numSamples)
+                      {
+                          AudioBuffer<float> input(dest, numChannels, numSamples);
+                          reader->read(&input, 0, numSamples, inputStart, true, true);
+                      });
+
+    return new ResidentSampleData(std::move(buffer), sampleRate, durationInSec);
+}
+
+
+SampleData::Ptr SampleLoader::convert(SampleData::Ptr sample, int bitDepth, bool isDoublePrecision)
+{
+    //mapped and streamed samples stay as they are and convert per block
+    auto* resident = dynamic_cast<ResidentSampleData*>(sample.get());
+
+    if(resident == nullptr)
+        return sample;
+
+    if(bitDepth == 16 || bitDepth == 24)
+        return new CompressedSampleData(resident->getBuffer(), resident->getSampleRate(), resident->getDurationInSec(), bitDepth);
+
+    if(isDoublePrecision)
+    {
+        AudioBuffer<double> buffer;
+        buffer.makeCopyOf(resident->getBuffer());
+
+        return new ResidentDoubleSampleData(std::move(buffer), resident->getSampleRate(), resident->getDurationInSec());
+    }
+
+    return sample;
+}
+
+
+void SampleLoader::publish(SampleData::Ptr sample)
+{
+    releaseRetiredSamples();
+
+    //the pending slot takes its own reference
+    sample->incReferenceCount();
+
+    //the audio thread never picked up the previous one, so it is safe to drop here
+    if(auto* previous = mPending.exchange(sample.get()))
+        previous->decReferenceCount();
+}
+
+
+void SampleLoader::releaseRetiredSamples()
+{
+    const ScopedLock sl(mReleaseLock);
+
+    const auto scope = mRetiredFifo.read(mRetiredFifo.getNumReady());
+
+    for(int i = 0; i < scope.blockSize1; i++)
+        mRetired[static_cast<size_t>(scope.startIndex1 + i)]->decReferenceCount();
+
+    for(int i = 0; i < scope.blockSize2; i++)
+        mRetired[static_cast<size_t>(scope.startIndex2 + i)]->decReferenceCount();
+
+    //samples no instance plays any more
+    if(scope.blockSize1 + scope.blockSize2 > 0)
+        mStore->releaseUnused();
+}
+
+
+void SampleLoader::timerCallback()
+{
+    //the audio thread can't release what it swapped out, and without a new load nothing else would
+    if(mRetiredFifo.getNumReady() > 0)
+        releaseRetiredSamples();
+}
+
+//==============================================================================
+bool SampleLoader::updateCurrentSample() noexcept
+{
+    //no room to retire the current sample, try again next block
+    if(mCurrent != nullptr && mRetiredFifo.getFreeSpace() == 0)
+        return false;
+
+    auto* next = mPending.exchange(nullptr);
+    if(next == nullptr)
+        return false;
+
+    if(mCurrent != nullptr)
+    {
+        const auto scope = mRetiredFifo.write(1);
+        mRetired[static_cast<size_t>(scope.startIndex1)] = mCurrent;
+    }
+
+    mCurrent = next;
+    return true;
+}
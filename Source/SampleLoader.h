@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    SampleLoader.h
+    Created: 17 Oct 2026 9:52:40am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+#include "StreamingSampleData.h"
+#include "MappedSampleData.h"
+#include "PolyphaseResampler.h"
+#include "SampleCache.h"
+#include "SampleStore.h"
+#include "CompressedSampleData.h"
+#include "EmbeddedSample.h"
+#include "SampleLoaderPool.h"
+
+
+//==============================================================================
+/**
+ Decodes and resamples files on the shared SampleLoaderPool and hands the finished
+ SampleData to the audio thread. Samples are shared with every other
+ instance through the SampleStore, and decoded files go through the on-disk
+ SampleCache, so the next session maps them instead of decoding again.
+
+ With embedding on, every file loaded is also kept as an EmbeddedSample for
+ the plugin state. An embedded sample restored from a state replaces the file
+ at its path: loading that path decodes from memory and never touches the
+ disk or the cache.
+
+ The hand-off is a single atomic pointer swap which processBlock picks up at
+ the start of a block. Buffers the audio thread has finished with are pushed
+ into a small FIFO and released on the message thread by a timer, or by the
+ next load, so a replaced sample doesn't stay in memory until then.
+*/
+class SampleLoader : private Timer
+{
+public:
+    SampleLoader(AudioFormatManager& formatManager);
+    ~SampleLoader() override;
+
+    //==============================================================================
+    //message thread: queue a decode, any older request still pending is dropped
+    //numChannels <= 0 keeps the channels of the file
+    void loadFile(const File& file, double sampleRate, int numChannels);
+    void loadBeep(double sampleRate, int numChannels);
+
+    //whether the latest request was made for this rate and channel count, and the current precision
+    bool isRequestedFor(double sampleRate, int numChannels) const noexcept
+    {
+        return mRequestedSampleRate.load() == sampleRate && mRequestedNumChannels.load() == numChannels
+            && mRequestedDoublePrecision.load() == mDoublePrecision.load();
+    }
+
+    //files longer than this are streamed from disk instead of decoded into memory, from the next load on
+    void setStreamingThreshold(float seconds) noexcept { mStreamingThresholdInSec.store(seconds); }
+    float getStreamingThreshold() const noexcept { return mStreamingThresholdInSec.load(); }
+
+    //16 or 24 keeps decoded samples quantised to that bit depth, then losslessly coded, 0 keeps them as float
+    void setCompressedBitDepth(int bitDepth) noexcept { mCompressedBitDepth.store(bitDepth); }
+    int getCompressedBitDepth() const noexcept { return mCompressedBitDepth.load(); }
+
+    //true keeps uncompressed samples as double, for hosts processing in double precision
+    void setDoublePrecision(bool shouldUseDouble) noexcept { mDoublePrecision.store(shouldUseDouble); }
+
+    //message thread: true keeps the loaded file as an EmbeddedSample, false drops the current one
+    void setEmbedding(bool shouldEmbed);
+    bool isEmbedding() const noexcept { return mEmbedding.load(); }
+
+    //message thread: the sample restored from a state, loaded instead of the file at its path
+    void setEmbeddedSample(const String& path, MemoryBlock data, const String& hash);
+
+    //the sample to save in the state, may be nullptr or belong to an earlier file
+    EmbeddedSample::Ptr getEmbeddedSample() const;
+    bool hasEmbeddedSampleFor(const File& file) const;
+
+    //waits until every load this loader queued has finished, returns false on timeout
+    bool waitUntilIdle(int timeoutMs);
+
+    //whether the latest request published its sample, false while it loads or when it failed
+    bool hasLatestSample() const noexcept { return mPublishedRequest.load() == mLatestRequest.load(); }
+
+    //the pool shared by every loader in the process
+    SampleLoaderPool& getPool() noexcept { return *mPool; }
+
+    //==============================================================================
+    /*
+     Audio thread only. Swaps in a newly published sample if there is one.
+     Returns true when the sample changed during this call.
+     */
+    bool updateCurrentSample() noexcept;
+
+    //audio thread only, may be nullptr
+    SampleData* getCurrentSample() const noexcept { return mCurrent; }
+
+private:
+    //==============================================================================
+    void addLoadJob(std::function<SampleData::Ptr()> createSample);
+    void loadEmbedded(EmbeddedSample::Ptr embedded, double sampleRate, int numChannels);
+    void setEmbeddedSample(EmbeddedSample::Ptr embedded);
+
+    SampleData::Ptr decode(std::unique_ptr<AudioFormatReader> reader, double sampleRate, int numChannels, float streamingThresholdInSec);
+    static SampleData::Ptr convert(SampleData::Ptr sample, int bitDepth, bool isDoublePrecision);
+    void publish(SampleData::Ptr sample);
+    void releaseRetiredSamples();
+    void timerCallback() override;
+
+    //==============================================================================
+    AudioFormatManager& mFormatManager;
+    SharedResourcePointer<SampleLoaderPool> mPool;
+    CriticalSection mPublishLock;
+    SharedResourcePointer<SampleCache> mCache;
+    SharedResourcePointer<SampleStore> mStore;
+    SharedResourcePointer<EmbeddedSample::Registry> mEmbeddedRegistry;
+
+    EmbeddedSample::Ptr mEmbedded;
+    mutable SpinLock mEmbeddedLock;
+    std::atomic<bool> mEmbedding { false };
+
+    std::atomic<int> mLatestRequest { 0 };
+    std::atomic<int> mPublishedRequest { -1 };
+    std::atomic<float> mStreamingThresholdInSec { 20.f };
+    std::atomic<int> mCompressedBitDepth { 0 };
+    std::atomic<bool> mDoublePrecision { false };
+    std::atomic<bool> mRequestedDoublePrecision { false };
+    std::atomic<double> mRequestedSampleRate { 0. };
+    std::atomic<int> mRequestedNumChannels { 0 };
+
+    //one reference is owned by whichever slot holds the pointer
+    std::atomic<SampleData*> mPending { nullptr };
+    SampleData* mCurrent = nullptr;
+
+    //samples the audio thread swapped out, waiting to be released
+    static constexpr int retiredCapacity = 16;
+    AbstractFifo mRetiredFifo { retiredCapacity };
+    std::array<SampleData*, retiredCapacity> mRetired {};
+    CriticalSection mReleaseLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleLoader)
+};
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    SampleLoaderPool.cpp
+    Created: 23 Oct 2026 5:03:18pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "SampleLoaderPool.h"
+
+
+//==============================================================================
+//counts itself done when it is deleted, whether it ran or was dropped
+class SampleLoaderPool::Job : public ThreadPoolJob
+{
+public:
+    Job(SampleLoaderPool& pool, const void* owner, std::function<void()> work)
+        : ThreadPoolJob("Sample load"), mPool(pool), mOwner(owner), mWork(std::move(work)) {}
+
+    ~Job() override { mPool.jobDone(mOwner); }
+
+    JobStatus runJob() override
+    {
+        mWork();
+        return jobHasFinished;
+    }
+
+    const void* getOwner() const noexcept { return mOwner; }
+
+private:
+    SampleLoaderPool& mPool;
+    const void* mOwner;
+    std::function<void()> mWork;
+};
+
+
+class SampleLoaderPool::OwnerSelector : public ThreadPool::JobSelector
+{
+public:
+    OwnerSelector(const void* owner) : mOwner(owner) {}
+
+    bool isJobSuitable(ThreadPoolJob* job) override
+    {
+        if(auto* loaderJob = dynamic_cast<Job*>(job))
+            return loaderJob->getOwner() == mOwner;
+
+        return false;
+    }
+
+private:
+    const void* mOwner;
+};
+
+
+//==============================================================================
+SampleLoaderPool::SampleLoaderPool()
+    : mThreadPool(jmax(1, SystemStats::getNumCpus()))
+{
+    mIdle.signal();
+}
+
+
+SampleLoaderPool::~SampleLoaderPool()
+{
+    //every loader removed its jobs before letting go of the pool
+    mThreadPool.removeAllJobs(true, 5000);
+}
+
+//==============================================================================
+void SampleLoaderPool::addJob(const void* owner, std::function<void()> work)
+{
+    //a waiting job of this owner is superseded, it would be dropped when it starts anyway
+    OwnerSelector selector(owner);
+    mThreadPool.removeAllJobs(false, 0, &selector);
+
+    {
+        const ScopedLock sl(mLock);
+
+        if(mProgress.numFinished == mProgress.numJobs)
+            mProgress = {};
+
+        mProgress.numJobs++;
+        mNumJobsPerOwner[owner]++;
+        mIdle.reset();
+    }
+
+    mThreadPool.addJob(new Job(*this, owner, std::move(work)), true);
+}
+
+
+bool SampleLoaderPool::removeJobs(const void* owner, int timeoutMs)
+{
+    OwnerSelector selector(owner);
+    return mThreadPool.removeAllJobs(true, timeoutMs, &selector);
+}
+
+
+int SampleLoaderPool::getNumJobs(const void* owner) const
+{
+    const ScopedLock sl(mLock);
+
+    auto entry = mNumJobsPerOwner.find(owner);
+    return entry != mNumJobsPerOwner.end() ? entry->second : 0;
+}
+
+
+void SampleLoaderPool::jobDone(const void* owner)
+{
+    const ScopedLock sl(mLock);
+
+    mProgress.numFinished++;
+
+    auto entry = mNumJobsPerOwner.find(owner);
+    if(entry != mNumJobsPerOwner.end() && --entry->second <= 0)
+        mNumJobsPerOwner.erase(entry);
+
+    if(mProgress.numFinished == mProgress.numJobs)
+        mIdle.signal();
+}
+
+//==============================================================================
+SampleLoaderPool::Progress SampleLoaderPool::getProgress() const
+{
+    const ScopedLock sl(mLock);
+    return mProgress;
+}
+
+
+bool SampleLoaderPool::isIdle() const
+{
+    const ScopedLock sl(mLock);
+    return mProgress.numFinished == mProgress.numJobs;
+}
+
+
+bool SampleLoaderPool::waitUntilIdle(int timeoutMs)
+{
+    return mIdle.wait(timeoutMs);
+}
@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    SampleLoaderPool.h
+    Created: 23 Oct 2026 5:03:18pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <map>
+
+
+//==============================================================================
+/**
+ The worker threads every SampleLoader in the process queues its decodes on,
+ one per core. A session restoring many instances decodes in parallel
+ instead of one file after another, and the host's project load returns as
+ soon as the decodes are queued.
+
+ Each owner has at most one job waiting: queueing a new one drops the older
+ ones that haven't started, since only the latest request of a loader is ever
+ published. Progress counts the jobs since the pool was last idle, so a
+ session load shows up as one run from 0 to all of them.
+*/
+class SampleLoaderPool
+{
+public:
+    SampleLoaderPool();
+    ~SampleLoaderPool();
+
+    //==============================================================================
+    //any thread but the audio thread
+    void addJob(const void* owner, std::function<void()> work);
+
+    //drops the owner's waiting jobs and waits for its running ones, returns false on timeout, < 0 never times out
+    bool removeJobs(const void* owner, int timeoutMs);
+
+    //jobs of this owner waiting or running
+    int getNumJobs(const void* owner) const;
+
+    //==============================================================================
+    struct Progress
+    {
+        int numJobs = 0;     //queued since the pool was last idle
+        int numFinished = 0; //of those, finished or dropped
+    };
+
+    Progress getProgress() const;
+    bool isIdle() const;
+
+    //returns false on timeout
+    bool waitUntilIdle(int timeoutMs);
+
+    int getNumThreads() const noexcept { return mThreadPool.getNumThreads(); }
+
+private:
+    //==============================================================================
+    class Job;
+    class OwnerSelector;
+    void jobDone(const void* owner);
+
+    CriticalSection mLock;
+    std::map<const void*, int> mNumJobsPerOwner;
+    Progress mProgress;
+    WaitableEvent mIdle { true };
+
+    //last, so the jobs it still holds are deleted while the counters exist
+    ThreadPool mThreadPool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleLoaderPool)
+};
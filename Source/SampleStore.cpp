@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    SampleStore.cpp
+    Created: 20 Oct 2026 10:08:41am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "SampleStore.h"
+
+
+//==============================================================================
+SampleData::Ptr SampleStore::getOrCreate(const String& path, double sampleRate, int numChannels,
+                                         const std::function<SampleData::Ptr()>& create)
+{
+    const String key = path + "|" + String(sampleRate) + "|" + String(numChannels);
+
+    std::promise<SampleData::Ptr> promise;
+    std::shared_future<SampleData::Ptr> future;
+    bool isBuilder = false;
+
+    {
+        const ScopedLock sl(mLock);
+        releaseUnusedLocked();
+
+        auto entry = mEntries.find(key);
+
+        if(entry != mEntries.end())
+            future = entry->second;
+        else
+        {
+            future = promise.get_future().share();
+            mEntries.emplace(key, future);
+            isBuilder = true;
+        }
+    }
+
+    if(! isBuilder)
+    {
+        //blocks while another instance is still building it
+        auto sample = future.get();
+
+        if(sample != nullptr && sample->isShareable())
+            return sample;
+
+        return create();
+    }
+
+    auto sample = create();
+    promise.set_value(sample);
+
+    //failed loads are retried next time, unshareable ones are never looked up again
+    if(sample == nullptr || ! sample->isShareable())
+    {
+        const ScopedLock sl(mLock);
+        mEntries.erase(key);
+    }
+
+    return sample;
+}
+
+
+void SampleStore::releaseUnused()
+{
+    const ScopedLock sl(mLock);
+    releaseUnusedLocked();
+}
+
+
+int SampleStore::getNumSamples() const
+{
+    const ScopedLock sl(mLock);
+    return static_cast<int>(mEntries.size());
+}
+
+//==============================================================================
+void SampleStore::releaseUnusedLocked()
+{
+    for(auto entry = mEntries.begin(); entry != mEntries.end();)
+    {
+        const auto& future = entry->second;
+
+        //still being built
+        if(future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            ++entry;
+            continue;
+        }
+
+        //the future's copy is the only reference left
+        const auto& sample = future.get();
+
+        if(sample == nullptr || sample->getReferenceCount() == 1)
+            entry = mEntries.erase(entry);
+        else
+            ++entry;
+    }
+}
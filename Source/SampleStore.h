@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    SampleStore.h
+    Created: 20 Oct 2026 10:08:41am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+
+#include <future>
+#include <map>
+
+
+//==============================================================================
+/**
+ Every sample loaded in the process, shared between plugin instances.
+
+ Samples are immutable once built, so instances asking for the same file at
+ the same rate and channel count get the same object. While one instance is
+ still building a sample, the others asking for it wait for that result
+ instead of decoding it again.
+
+ The store holds one reference to every sample. Entries nobody else refers
+ to any more are dropped the next time the store is used, or on
+ releaseUnused().
+*/
+class SampleStore
+{
+public:
+    SampleStore() = default;
+
+    //==============================================================================
+    /*
+     Returns the shared sample for this key, calling create() when nobody has
+     built it yet. Samples that aren't shareable are never handed to a second
+     caller, those callers create their own.
+     */
+    SampleData::Ptr getOrCreate(const String& path, double sampleRate, int numChannels,
+                                const std::function<SampleData::Ptr()>& create);
+
+    void releaseUnused();
+
+    int getNumSamples() const;
+
+private:
+    //==============================================================================
+    void releaseUnusedLocked();
+
+    CriticalSection mLock;
+    std::map<String, std::shared_future<SampleData::Ptr>> mEntries;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleStore)
+};
@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    StreamingSampleData.cpp
+    Created: 17 Oct 2026 11:05:27am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "StreamingSampleData.h"
+#include "RealtimeCheck.h"
+
+
+//==============================================================================
+StreamingSampleData::StreamingSampleData(std::unique_ptr<AudioFormatReader> reader, double sampleRate, int numChannels,
+                                         float preloadInSec, float ringInSec)
+    : SampleData(numChannels,
+                 juce::roundToInt(reader->lengthInSamples * sampleRate / reader->sampleRate),
+                 sampleRate,
+                 static_cast<float>(reader->lengthInSamples / reader->sampleRate)),
+      mReader(std::move(reader)),
+      mFifo(jmax(2, juce::roundToInt(ringInSec * sampleRate / chunkSize) + 1))
+{
+    if(mReader->sampleRate != sampleRate)
+        mResampler = std::make_unique<PolyphaseResampler>(mReader->sampleRate, sampleRate, numChannels);
+
+    //the head of the file stays resident, the stream continues right after it
+    const int preloadLength = jmin(getLengthInSamples(), juce::roundToInt(preloadInSec * sampleRate));
+    mPreload.setSize(numChannels, preloadLength);
+    renderFromSource(mPreload, 0, preloadLength);
+    mWritePos = preloadLength;
+
+    const int numChunks = mFifo.getTotalSize();
+    mRing.setSize(numChannels, numChunks * chunkSize);
+    mChunkStart.resize(static_cast<size_t>(numChunks), 0);
+    mChunkLength.resize(static_cast<size_t>(numChunks), 0);
+    mChunkGeneration.resize(static_cast<size_t>(numChunks), 0);
+
+    mThread->addTimeSliceClient(this);
+}
+
+
+StreamingSampleData::~StreamingSampleData()
+{
+    //blocks until useTimeSlice has returned
+    mThread->removeTimeSliceClient(this);
+}
+
+//==============================================================================
+void StreamingSampleData::readSamples(float* const* dest, int numDestChannels, int startSample, int numSamples) noexcept
+{
+    const int numCopyChannels = jmin(numDestChannels, getNumChannels());
+    const int preloadLength = mPreload.getNumSamples();
+    int done = 0;
+
+    //chunks left over from the previous trigger
+    for(;;)
+    {
+        int start1, size1, start2, size2;
+        mFifo.prepareToRead(1, start1, size1, start2, size2);
+
+        if(size1 == 0 || mChunkGeneration[static_cast<size_t>(start1)] == mGeneration)
+            break;
+
+        mFifo.finishedRead(1);
+    }
+
+    //the resident head of the file
+    if(startSample < preloadLength)
+    {
+        done = jmin(numSamples, preloadLength - startSample);
+
+        for(int channel = 0; channel < numCopyChannels; channel++)
+            FloatVectorOperations::copy(dest[channel], mPreload.getReadPointer(channel, startSample), done);
+    }
+
+    //the rest comes from the ring
+    while(done < numSamples)
+    {
+        const int position = startSample + done;
+        if(position >= getLengthInSamples())
+            break;
+
+        int start1, size1, start2, size2;
+        mFifo.prepareToRead(1, start1, size1, start2, size2);
+
+        if(size1 == 0)
+        {
+            if(mIsNonRealtime && waitForChunk())
+                continue;
+
+            mNumUnderruns++;
+            break;
+        }
+
+        const auto slot = static_cast<size_t>(start1);
+        const int chunkStart = mChunkStart[slot];
+        const int chunkEnd = chunkStart + mChunkLength[slot];
+
+        //already played past this chunk, or the reader finished it just before a rewind
+        if(chunkEnd <= position || mChunkGeneration[slot] != mGeneration)
+        {
+            mFifo.finishedRead(1);
+            continue;
+        }
+
+        //the chunk for this position was never read
+        if(chunkStart > position)
+        {
+            mNumUnderruns++;
+            break;
+        }
+
+        const int num = jmin(numSamples - done, chunkEnd - position);
+        const int ringOffset = start1 * chunkSize + (position - chunkStart);
+
+        for(int channel = 0; channel < numCopyChannels; channel++)
+            FloatVectorOperations::copy(dest[channel] + done, mRing.getReadPointer(channel, ringOffset), num);
+
+        done += num;
+
+        if(position + num == chunkEnd)
+            mFifo.finishedRead(1);
+    }
+
+    clearRemainder(dest, numDestChannels, numCopyChannels, done, numSamples);
+}
+
+
+void StreamingSampleData::rewind(int startSample) noexcept
+{
+    mGeneration++;
+    mRequestedStart.store(jmax(0, startSample));
+    mRequestedGeneration.store(mGeneration);
+
+    //free the ring so the reader can refill it for this trigger right away
+    mFifo.finishedRead(mFifo.getNumReady());
+}
+
+
+bool StreamingSampleData::waitForChunk() noexcept
+{
+    //the host waits for the block anyway, so this may block like the reader does
+    const RealtimeCheck::ScopedNonRealtime nonRealtime;
+    const auto start = Time::getMillisecondCounter();
+
+    while(mFifo.getNumReady() == 0)
+    {
+        //a reader that can't keep up for this long is stuck, give up and play silence
+        if(Time::getMillisecondCounter() - start > 5000)
+            return false;
+
+        mThread->moveToFrontOfQueue(this);
+        mThread->notify();
+        Thread::sleep(1);
+    }
+
+    return true;
+}
+
+//==============================================================================
+int StreamingSampleData::useTimeSlice()
+{
+    const int requested = mRequestedGeneration.load();
+
+    if(requested != mProducerGeneration)
+    {
+        //the head is resident, anything before the requested start won't be played
+        mProducerGeneration = requested;
+        mWritePos = jlimit(mPreload.getNumSamples(), getLengthInSamples(), mRequestedStart.load());
+        restartSource(mWritePos);
+    }
+
+    while(mWritePos < getLengthInSamples() && mFifo.getFreeSpace() > 0)
+    {
+        //a new trigger came in, restart on the next slice
+        if(mRequestedGeneration.load() != mProducerGeneration)
+            return 0;
+
+        int start1, size1, start2, size2;
+        mFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        const auto slot = static_cast<size_t>(start1);
+        const int length = jmin(static_cast<int>(chunkSize), getLengthInSamples() - mWritePos);
+
+        renderFromSource(mRing, start1 * chunkSize, length);
+
+        mChunkStart[slot] = mWritePos;
+        mChunkLength[slot] = length;
+        mChunkGeneration[slot] = mProducerGeneration;
+
+        mFifo.finishedWrite(1);
+        mWritePos += length;
+    }
+
+    return 20;
+}
+
+
+void StreamingSampleData::restartSource(int position)
+{
+    mSourcePos = position;
+
+    //the resampler computes every output sample on its own, so it can jump straight there
+    if(mResampler != nullptr)
+        mResampler->setPosition(position);
+}
+
+
+void StreamingSampleData::renderFromSource(AudioBuffer<float>& dest, int startSample, int numSamples)
+{
+    if(numSamples <= 0)
+        return;
+
+    const int numChannels = jmin(dest.getNumChannels(), 64);
+
+    auto readInput = [this, numChannels] (float* const* channels, int64 inputStart, int numInput)
+    {
+        AudioBuffer<float> input(channels, numChannels, numInput);
+        mReader->read(&input, 0, numInput, inputStart, true, true);
+    };
+
+    float* channels[64];
+    for(int channel = 0; channel < numChannels; channel++)
+        channels[channel] = dest.getWritePointer(channel, startSample);
+
+    if(mResampler != nullptr)
+        mResampler->process(channels, numSamples, readInput);
+    else
+        readInput(channels, mSourcePos, numSamples);
+
+    mSourcePos += numSamples;
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    StreamingSampleData.h
+    Created: 17 Oct 2026 11:05:27am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+#include "PolyphaseResampler.h"
+
+
+//==============================================================================
+/**
+ One read-ahead thread for every streaming sample in the process.
+*/
+struct SharedStreamingThread : public TimeSliceThread
+{
+    SharedStreamingThread() : TimeSliceThread("Repeator streaming")
+    {
+        startThread();
+    }
+
+    ~SharedStreamingThread() override
+    {
+        stopThread(5000);
+    }
+};
+
+
+//==============================================================================
+/**
+ A long sample played straight from disk.
+
+ The first few seconds stay resident so a trigger can start instantly. The
+ rest is read ahead of the playhead by a background thread into a lock-free
+ ring of fixed-size chunks. Every chunk is tagged with its position and with
+ the trigger it was read for, so after a rewind the audio thread simply skips
+ chunks that belong to an older trigger.
+
+ A rewind past the resident head restarts the read-ahead there, so playback
+ that starts in the middle of a trigger still finds its audio. When the host
+ renders offline it runs faster than the disk, so reads wait for the chunk
+ they need instead of playing silence.
+*/
+class StreamingSampleData : public SampleData,
+                            private TimeSliceClient
+{
+public:
+    StreamingSampleData(std::unique_ptr<AudioFormatReader> reader, double sampleRate, int numChannels,
+                        float preloadInSec = 2.f, float ringInSec = 2.f);
+    ~StreamingSampleData() override;
+
+    //==============================================================================
+    using SampleData::readSamples;
+    void readSamples(float* const* dest, int numDestChannels, int startSample, int numSamples) noexcept override;
+    void rewind(int startSample) noexcept override;
+    void setNonRealtime(bool isNonRealtime) noexcept override { mIsNonRealtime = isNonRealtime; }
+
+    //the read-ahead ring follows the playhead of one instance
+    bool isShareable() const noexcept override { return false; }
+
+    //how often the audio thread reached a chunk that wasn't read yet
+    int getNumUnderruns() const noexcept { return mNumUnderruns.load(); }
+
+private:
+    //==============================================================================
+    int useTimeSlice() override;
+
+    //offline only, blocks until the reader has filled the next chunk, false when it didn't in time
+    bool waitForChunk() noexcept;
+
+    void restartSource(int position);
+    void renderFromSource(AudioBuffer<float>& dest, int startSample, int numSamples);
+
+    //==============================================================================
+    static constexpr int chunkSize = 4096;
+
+    std::unique_ptr<AudioFormatReader> mReader;
+    std::unique_ptr<PolyphaseResampler> mResampler;
+    int mSourcePos = 0;
+
+    AudioBuffer<float> mPreload;
+
+    //the ring, one chunk per fifo slot
+    AudioBuffer<float> mRing;
+    std::vector<int> mChunkStart;
+    std::vector<int> mChunkLength;
+    std::vector<int> mChunkGeneration;
+    AbstractFifo mFifo;
+
+    //written by the audio thread on every rewind, the start before the generation
+    std::atomic<int> mRequestedStart { 0 };
+    std::atomic<int> mRequestedGeneration { 0 };
+    int mGeneration = 0;
+    bool mIsNonRealtime = false;
+
+    //background thread only
+    int mProducerGeneration = 0;
+    int mWritePos = 0;
+
+    std::atomic<int> mNumUnderruns { 0 };
+
+    SharedResourcePointer<SharedStreamingThread> mThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamingSampleData)
+};
@@ -0,0 +1,459 @@
+/*
+  ==============================================================================
+
+    TriggerScheduler.cpp
+    Created: 24 Oct 2026 9:47:21am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "TriggerScheduler.h"
+
+
+namespace
+{
+    //a uniform value in [0, 1) that only depends on the seed and the trigger number
+    double hashToUnit(uint32 seed, int64 index) noexcept
+    {
+        uint64 x = (static_cast<uint64>(seed) << 32) ^ static_cast<uint64>(index);
+
+        //splitmix64
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        x ^= x >> 31;
+
+        return static_cast<double>(x >> 11) / static_cast<double>(1ull << 53);
+    }
+
+    int64 floorDivide(int64 value, int64 divisor) noexcept
+    {
+        const int64 quotient = value / divisor;
+        return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+    }
+
+    //how far a carried bar line may be from the recomputed one and still be the same, hosts round their PPQ
+    constexpr int64 maxBarDrift = 16;
+}
+
+
+//==============================================================================
+TriggerScheduler::TriggerScheduler()
+{
+    setGrid();
+    update();
+}
+
+
+TriggerScheduler::~TriggerScheduler()
+{
+    releaseRetired();
+
+    if(auto* pending = mPending.exchange(nullptr))
+        pending->decReferenceCount();
+
+    if(mCurrent != nullptr)
+        mCurrent->decReferenceCount();
+}
+
+//==============================================================================
+void TriggerScheduler::setGrid()
+{
+    setSchedule(new Schedule());
+}
+
+
+void TriggerScheduler::setJitter(float amount, uint32 seed)
+{
+    auto* schedule = new Schedule();
+    schedule->mode = Mode::jitter;
+    schedule->jitter = jlimit(0.f, maxJitter, amount);
+    schedule->seed = seed;
+
+    setSchedule(schedule);
+}
+
+
+void TriggerScheduler::setList(std::vector<double> timesInSec)
+{
+    //negative times can never be reached, the index has to be sorted
+    timesInSec.erase(std::remove_if(timesInSec.begin(), timesInSec.end(), [] (double time) { return ! (time >= 0.); }),
+                     timesInSec.end());
+    std::sort(timesInSec.begin(), timesInSec.end());
+
+    //a rate set meanwhile would otherwise be missed by both this and setSampleRate()
+    const ScopedLock lock(mLatestLock);
+    const double sampleRate = mSampleRate.load();
+
+    auto* schedule = new Schedule();
+    schedule->mode = Mode::list;
+    schedule->timesInSec = std::move(timesInSec);
+    schedule->sampleRate = sampleRate;
+
+    //in samples as the host counts them
+    schedule->positions.reserve(schedule->timesInSec.size());
+    for(auto time : schedule->timesInSec)
+        schedule->positions.push_back(static_cast<int64>(std::llround(time * sampleRate)));
+
+    setSchedule(schedule);
+}
+
+
+void TriggerScheduler::setBars(int barsPerTrigger)
+{
+    auto* schedule = new Schedule();
+    schedule->mode = Mode::bars;
+    schedule->bars = jmax(1, barsPerTrigger);
+
+    setSchedule(schedule);
+}
+
+
+TriggerScheduler::Schedule::Ptr TriggerScheduler::getSchedule() const
+{
+    const ScopedLock lock(mLatestLock);
+    return mLatest;
+}
+
+
+void TriggerScheduler::setSampleRate(double sampleRate)
+{
+    const ScopedLock lock(mLatestLock);
+    mSampleRate.store(sampleRate);
+
+    if(mLatest->mode == Mode::list && mLatest->sampleRate != sampleRate)
+        setList(mLatest->timesInSec);
+}
+
+
+void TriggerScheduler::setSchedule(Schedule* schedule)
+{
+    const ScopedLock lock(mLatestLock);
+    releaseRetired();
+
+    mLatest = schedule;
+
+    //the pending slot takes its own reference
+    schedule->incReferenceCount();
+
+    if(auto* previous = mPending.exchange(schedule))
+        previous->decReferenceCount();
+}
+
+
+void TriggerScheduler::releaseRetired()
+{
+    const auto scope = mRetiredFifo.read(mRetiredFifo.getNumReady());
+
+    for(int i = 0; i < scope.blockSize1; i++)
+        mRetired[static_cast<size_t>(scope.startIndex1 + i)]->decReferenceCount();
+
+    for(int i = 0; i < scope.blockSize2; i++)
+        mRetired[static_cast<size_t>(scope.startIndex2 + i)]->decReferenceCount();
+}
+
+
+void TriggerScheduler::update() noexcept
+{
+    //no room to retire the current schedule, try again next block
+    if(mCurrent != nullptr && mRetiredFifo.getFreeSpace() == 0)
+        return;
+
+    auto* next = mPending.exchange(nullptr);
+    if(next == nullptr)
+        return;
+
+    if(mCurrent != nullptr)
+    {
+        const auto scope = mRetiredFifo.write(1);
+        mRetired[static_cast<size_t>(scope.startIndex1)] = mCurrent;
+    }
+
+    mCurrent = next;
+
+    //the bar lines may belong to another number of bars
+    mHasCarriedBars = false;
+}
+
+//==============================================================================
+void TriggerScheduler::setHostPosition(int64 blockStart, const AudioPlayHead::PositionInfo& position) noexcept
+{
+    const auto ppq = position.getPpqPosition();
+    const auto bpm = position.getBpm();
+    const double sampleRate = mSampleRate.load();
+
+    mHasMusicalTime = ppq.hasValue() && bpm.hasValue() && *bpm > 0. && sampleRate > 0.;
+    if(! mHasMusicalTime)
+        return;
+
+    int numerator = 4, denominator = 4;
+    if(auto signature = position.getTimeSignature())
+    {
+        numerator = jmax(1, signature->numerator);
+        denominator = jmax(1, signature->denominator);
+    }
+
+    mBlockStart = blockStart;
+    mPpqPosition = *ppq;
+    mSamplesPerQuarter = sampleRate * 60. / *bpm;
+    mBarLengthInQuarters = 4. * numerator / denominator;
+
+    //the host knows where the bar started after meter changes, otherwise the meter is taken as constant
+    if(auto barStart = position.getPpqPositionOfLastBarStart())
+        mBarStartPpq = *barStart;
+    else
+        mBarStartPpq = std::floor(mPpqPosition / mBarLengthInQuarters) * mBarLengthInQuarters;
+
+    if(auto barCount = position.getBarCount())
+        mBarIndex = *barCount;
+    else
+        mBarIndex = static_cast<int64>(std::llround(mBarStartPpq / mBarLengthInQuarters));
+}
+
+
+int64 TriggerScheduler::getBarAt(int64 position) const noexcept
+{
+    const double ppq = mPpqPosition + static_cast<double>(position - mBlockStart) / mSamplesPerQuarter;
+    return mBarIndex + static_cast<int64>(std::floor((ppq - mBarStartPpq) / mBarLengthInQuarters));
+}
+
+
+int64 TriggerScheduler::getBarStart(int64 bar) const noexcept
+{
+    const double ppq = mBarStartPpq + static_cast<double>(bar - mBarIndex) * mBarLengthInQuarters;
+    return mBlockStart + static_cast<int64>(std::llround((ppq - mPpqPosition) * mSamplesPerQuarter));
+}
+
+int64 TriggerScheduler::getBarTrigger(int64 index) const noexcept
+{
+    const int64 time = getBarStart(index * mCurrent->bars);
+
+    if(mHasCarriedBars)
+    {
+        //already played, it stays where it was
+        if(index == mCarriedPreviousIndex)
+            return mCarriedPrevious;
+
+        //moved by more than rounding means the tempo changed, but it is never moved into the last block
+        if(index == mCarriedNextIndex)
+            return std::abs(time - mCarriedNext) <= maxBarDrift ? mCarriedNext : jmax(time, mBlockStart);
+    }
+
+    return time;
+}
+
+
+bool TriggerScheduler::findBarTrigger(int64 position, bool isNext, int64& index, int64& trigger) const noexcept
+{
+    //trigger number n is on bar n * bars, rounding can move a bar line across position
+    const int64 barIndex = floorDivide(getBarAt(position), mCurrent->bars);
+
+    if(isNext)
+    {
+        for(int64 candidate = jmax((int64) 1, barIndex); candidate <= jmax((int64) 1, barIndex) + 2; candidate++)
+        {
+            const int64 time = getBarTrigger(candidate);
+
+            if(time > position)
+            {
+                index = candidate;
+                trigger = time;
+                return true;
+            }
+        }
+    }
+    else
+    {
+        for(int64 candidate = barIndex + 1; candidate >= jmax((int64) 1, barIndex - 1); candidate--)
+        {
+            const int64 time = getBarTrigger(candidate);
+
+            if(time <= position)
+            {
+                index = candidate;
+                trigger = time;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+void TriggerScheduler::startBlock(int64 blockStart, int numSamples, bool isPlaying) noexcept
+{
+    //anything but the block right after the last one is a jump, the bar lines are worked out afresh
+    if(blockStart != mNextBlockStart || ! mHasMusicalTime)
+        mHasCarriedBars = false;
+
+    mNextBlockStart = isPlaying && numSamples > 0 ? blockStart + numSamples : -1;
+}
+
+
+void TriggerScheduler::carryBarTriggers(int64 blockEnd) noexcept
+{
+    if(mCurrent->mode != Mode::bars || ! mHasMusicalTime)
+    {
+        mHasCarriedBars = false;
+        return;
+    }
+
+    //both are found before either is replaced, they may be carried ones themselves
+    int64 previousIndex = 0, previous = 0, nextIndex = 0, next = 0;
+    findBarTrigger(blockEnd - 1, false, previousIndex, previous);
+
+    if(! findBarTrigger(blockEnd - 1, true, nextIndex, next))
+    {
+        mHasCarriedBars = false;
+        return;
+    }
+
+    mCarriedPreviousIndex = previousIndex;
+    mCarriedPrevious = previous;
+    mCarriedNextIndex = nextIndex;
+    mCarriedNext = next;
+    mHasCarriedBars = true;
+}
+
+//==============================================================================
+int64 TriggerScheduler::getJitteredTrigger(int64 index) const noexcept
+{
+    //at most maxJitter / 2 of a period either way, so the triggers stay in order
+    const double offset = (hashToUnit(mCurrent->seed, index) - 0.5) * mCurrent->jitter * static_cast<double>(mPeriod);
+    return index * mPeriod + static_cast<int64>(std::llround(offset));
+}
+
+
+bool TriggerScheduler::findPreviousOnGrid(int64 position, int64& trigger) const noexcept
+{
+    if(mPeriod <= 0)
+        return false;
+
+    const int64 index = floorDivide(position, mPeriod);
+    if(index < 1)
+        return false;
+
+    trigger = index * mPeriod;
+    return true;
+}
+
+
+bool TriggerScheduler::findNextOnGrid(int64 position, int64& trigger) const noexcept
+{
+    if(mPeriod <= 0)
+        return false;
+
+    trigger = jmax((int64) 1, floorDivide(position, mPeriod) + 1) * mPeriod;
+    return true;
+}
+
+//==============================================================================
+bool TriggerScheduler::findPrevious(int64 position, int64& trigger) const noexcept
+{
+    switch(mCurrent->mode)
+    {
+        case Mode::grid:
+            return findPreviousOnGrid(position, trigger);
+
+        case Mode::jitter:
+        {
+            if(mPeriod <= 0)
+                return false;
+
+            //the trigger in the same period or either neighbour
+            const int64 index = floorDivide(position, mPeriod);
+
+            for(int64 candidate = index + 1; candidate >= jmax((int64) 1, index - 1); candidate--)
+            {
+                const int64 time = getJitteredTrigger(candidate);
+
+                if(time <= position)
+                {
+                    trigger = time;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        case Mode::bars:
+        {
+            if(! mHasMusicalTime)
+                return findPreviousOnGrid(position, trigger);
+
+            int64 index = 0;
+            return findBarTrigger(position, false, index, trigger);
+        }
+
+        case Mode::list:
+        {
+            const auto& positions = mCurrent->positions;
+
+            //the first trigger after position
+            auto next = std::upper_bound(positions.begin(), positions.end(), position);
+
+            if(next == positions.begin())
+                return false;
+
+            trigger = *std::prev(next);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool TriggerScheduler::findNext(int64 position, int64& trigger) const noexcept
+{
+    switch(mCurrent->mode)
+    {
+        case Mode::grid:
+            return findNextOnGrid(position, trigger);
+
+        case Mode::jitter:
+        {
+            if(mPeriod <= 0)
+                return false;
+
+            const int64 index = floorDivide(position, mPeriod);
+
+            for(int64 candidate = jmax((int64) 1, index); ; candidate++)
+            {
+                const int64 time = getJitteredTrigger(candidate);
+
+                if(time > position)
+                {
+                    trigger = time;
+                    return true;
+                }
+            }
+        }
+
+        case Mode::bars:
+        {
+            if(! mHasMusicalTime)
+                return findNextOnGrid(position, trigger);
+
+            int64 index = 0;
+            return findBarTrigger(position, true, index, trigger);
+        }
+
+        case Mode::list:
+        {
+            const auto& positions = mCurrent->positions;
+            auto next = std::upper_bound(positions.begin(), positions.end(), position);
+
+            if(next == positions.end())
+                return false;
+
+            trigger = *next;
+            return true;
+        }
+    }
+
+    return false;
+}
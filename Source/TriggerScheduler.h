@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    TriggerScheduler.h
+    Created: 17 Oct 2026 2:34:08pm
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+//==============================================================================
+/**
+ Works out, to the sample, where the watermark plays inside each block.
+
+ Triggers sit at fixed places on the timeline, counted in 64-bit samples from
+ the host's zero, so they don't depend on where playback started, how often it
+ jumped or what block size the host uses. A render from any point matches the
+ same stretch of a full render.
+
+ The Schedule says where the triggers are:
+ - grid: every period, the first one a period after zero
+ - jitter: the grid, each trigger moved by up to half the jitter amount of a
+   period either way, the same for a given seed every time
+ - list: explicit times, kept sorted and converted to samples once per
+   sample rate
+ - bars: every few bars of the host's musical time, from its PPQ position,
+   tempo and time signature. The bar lines are worked out from the position
+   of every block, so tempo and meter changes are followed and the cost
+   doesn't grow with the session. While playback runs on without a jump, the
+   bar lines either side of a block boundary are carried over to the next
+   block, so the host rounding its PPQ can't move one across the boundary.
+   Without a tempo from the host it falls back to the grid.
+
+ Finding the trigger around any position is a binary search of the list, or
+ arithmetic on the grid, so a seek costs the same anywhere on the timeline.
+
+ Schedules are immutable and handed to the audio thread like samples: an
+ atomic pointer swap at the start of a block, with the replaced ones released
+ later on the message thread.
+*/
+class TriggerScheduler
+{
+public:
+    //==============================================================================
+    enum class Mode
+    {
+        grid = 0,
+        jitter,
+        list,
+        bars
+    };
+
+    struct Schedule : public ReferenceCountedObject
+    {
+        using Ptr = ReferenceCountedObjectPtr<Schedule>;
+
+        Mode mode = Mode::grid;
+        float jitter = 0.f;          //0 to maxJitter, a share of the period
+        uint32 seed = 0;
+        std::vector<double> timesInSec; //sorted, list mode only
+        std::vector<int64> positions;   //timesInSec at sampleRate
+        double sampleRate = 0.;
+        int bars = 1;                   //bars mode only
+    };
+
+    static constexpr float maxJitter = 0.9f;
+
+    //==============================================================================
+    TriggerScheduler();
+    ~TriggerScheduler();
+
+    //message thread, or whichever thread the host prepares on
+    void setGrid();
+    void setJitter(float amount, uint32 seed);
+    void setList(std::vector<double> timesInSec);
+    void setBars(int barsPerTrigger);
+
+    //the schedule last set, for the state
+    Schedule::Ptr getSchedule() const;
+
+    //==============================================================================
+    //before processing starts, converts a list schedule for the new rate, hosts may call it off the message thread
+    void setSampleRate(double sampleRate);
+
+    //audio thread, or before processing starts, a period of 0 means no grid or jitter triggers at all
+    void setPeriod(int64 periodInSamples) noexcept  { mPeriod = jmax((int64) 0, periodInSamples); }
+    void setDuration(int64 durationInSamples) noexcept { mDuration = jmax((int64) 0, durationInSamples); }
+
+    //the host's musical position at blockStart, for bars mode, every block before process()
+    void setHostPosition(int64 blockStart, const AudioPlayHead::PositionInfo& position) noexcept;
+    void clearHostPosition() noexcept { mHasMusicalTime = false; }
+
+    //the last trigger at or before position, and the first one after it, false when there is none
+    bool findPrevious(int64 position, int64& trigger) const noexcept;
+    bool findNext(int64 position, int64& trigger) const noexcept;
+
+    //==============================================================================
+    /*
+     Calls onSegment(startInBlock, numSamples, positionInTrigger, triggerLength)
+     for every part of the block where the watermark is playing.
+     positionInTrigger is 0 exactly on a trigger. A trigger cuts off the one
+     before it, triggerLength is how long the current one plays: the duration,
+     or less when the next trigger cuts it off, so it can fade out before the
+     cut as well.
+     */
+    template <typename Callback>
+    void process(int64 blockStart, int numSamples, bool isPlaying, Callback&& onSegment)
+    {
+        update();
+        startBlock(blockStart, numSamples, isPlaying);
+
+        if(! isPlaying || numSamples <= 0)
+            return;
+
+        const int64 blockEnd = blockStart + numSamples;
+        int64 now = blockStart;
+
+        int64 trigger = 0;
+        bool isTriggered = findPrevious(blockStart, trigger);
+
+        while(now < blockEnd)
+        {
+            int64 nextTrigger = 0;
+            const bool hasNext = findNext(now, nextTrigger);
+            if(! hasNext)
+                nextTrigger = blockEnd;
+
+            const int64 playEnd = isTriggered ? trigger + mDuration : now;
+
+            if(now < playEnd)
+            {
+                //a cut in a later block still shortens this one, so the fade out starts in time
+                const int64 triggerLength = hasNext ? jmin(mDuration, nextTrigger - trigger) : mDuration;
+                const int64 end = jmin(playEnd, nextTrigger, blockEnd);
+                onSegment(static_cast<int>(now - blockStart), static_cast<int>(end - now), now - trigger, triggerLength);
+                now = end;
+            }
+            else
+            {
+                now = jmin(nextTrigger, blockEnd);
+            }
+
+            if(now == nextTrigger && now < blockEnd)
+            {
+                trigger = nextTrigger;
+                isTriggered = true;
+            }
+        }
+
+        carryBarTriggers(blockEnd);
+    }
+
+private:
+    //==============================================================================
+    void setSchedule(Schedule* schedule);
+    void update() noexcept;
+    void releaseRetired();
+
+    //the jittered grid trigger number index, index >= 1
+    int64 getJitteredTrigger(int64 index) const noexcept;
+
+    //bars counted from the host's zero, in timeline samples at the current tempo
+    int64 getBarAt(int64 position) const noexcept;
+    int64 getBarStart(int64 bar) const noexcept;
+
+    //bars mode trigger number index, the carried position when there is one
+    int64 getBarTrigger(int64 index) const noexcept;
+    bool findBarTrigger(int64 position, bool isNext, int64& index, int64& trigger) const noexcept;
+
+    //forgets the carried bar lines after a jump, and keeps them after a block that played
+    void startBlock(int64 blockStart, int numSamples, bool isPlaying) noexcept;
+    void carryBarTriggers(int64 blockEnd) noexcept;
+
+    bool findPreviousOnGrid(int64 position, int64& trigger) const noexcept;
+    bool findNextOnGrid(int64 position, int64& trigger) const noexcept;
+
+    //==============================================================================
+    std::atomic<double> mSampleRate { 44100. };
+    int64 mPeriod = 0;
+    int64 mDuration = 0;
+
+    //the latest block's musical position
+    bool mHasMusicalTime = false;
+    int64 mBlockStart = 0;
+    double mPpqPosition = 0.;
+    double mSamplesPerQuarter = 1.;
+    double mBarStartPpq = 0.;
+    double mBarLengthInQuarters = 4.;
+    int64 mBarIndex = 0;
+
+    //the bars mode triggers either side of the last block's end, valid while playback continues
+    int64 mNextBlockStart = -1;
+    bool mHasCarriedBars = false;
+    int64 mCarriedPreviousIndex = 0, mCarriedPrevious = 0;
+    int64 mCarriedNextIndex = 0, mCarriedNext = 0;
+
+    //setting a schedule and the rate it is converted at, also keeps the retired FIFO to one reader
+    CriticalSection mLatestLock;
+    Schedule::Ptr mLatest;
+
+    //one reference is owned by whichever slot holds the pointer
+    std::atomic<Schedule*> mPending { nullptr };
+    Schedule* mCurrent = nullptr;
+
+    static constexpr int retiredCapacity = 8;
+    AbstractFifo mRetiredFifo { retiredCapacity };
+    std::array<Schedule*, retiredCapacity> mRetired {};
+
+    JUCE_DECLARE_NON_COPYABLE (TriggerScheduler)
+};
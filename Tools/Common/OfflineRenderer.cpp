@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 18 Oct 2026 10:02:44am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer(RepeatorAudioProcessor& processor)
+    : mProcessor(processor)
+{
+    mProcessor.setPlayHead(&mPlayHead);
+    mProcessor.setNonRealtime(true);
+}
+
+
+OfflineRenderer::~OfflineRenderer()
+{
+    mProcessor.releaseResources();
+    mProcessor.setPlayHead(nullptr);
+}
+
+//==============================================================================
+bool OfflineRenderer::prepare(const Settings& settings, double sampleRate, int numChannels)
+{
+    mBlockSize = jmax(1, settings.blockSize);
+
+    setParameter(mProcessor, "PERIOD", settings.periodInSec);
+    setParameter(mProcessor, "GAIN", settings.gainInDb);
+
+    mProcessor.setPlayConfigDetails(numChannels, numChannels, sampleRate, mBlockSize);
+    mProcessor.prepareToPlay(sampleRate, mBlockSize);
+
+    mPlayHead.setSampleRate(sampleRate);
+    mPlayHead.setPosition(0);
+
+    //prepareToPlay already reloads the sample when only the rate changed
+    if(settings.source != mSource)
+    {
+        if(! selectSource(mProcessor, settings.source))
+            return false;
+
+        mSource = settings.source;
+    }
+
+    if(! mProcessor.waitForSampleLoad(60000))
+        return false;
+
+    //a file that couldn't be decoded leaves nothing to play, the render would carry no watermark
+    return mProcessor.mMode.load() != PlaybackMode::sample || mProcessor.hasLoadedSample();
+}
+
+
+void OfflineRenderer::process(AudioBuffer<float>& buffer)
+{
+    process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+
+void OfflineRenderer::process(float* const* channels, int numChannels, int numSamples)
+{
+    processBlocks(channels, numChannels, numSamples);
+}
+
+
+void OfflineRenderer::process(AudioBuffer<double>& buffer)
+{
+    process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+
+void OfflineRenderer::process(double* const* channels, int numChannels, int numSamples)
+{
+    processBlocks(channels, numChannels, numSamples);
+}
+
+
+template<typename SampleType>
+void OfflineRenderer::processBlocks(SampleType* const* channels, int numChannels, int numSamples)
+{
+    for(int offset = 0; offset < numSamples; offset += mBlockSize)
+    {
+        const int num = jmin(mBlockSize, numSamples - offset);
+
+        SampleType* blockChannels[64];
+        const int numBlockChannels = jmin(numChannels, 64);
+
+        for(int channel = 0; channel < numBlockChannels; channel++)
+            blockChannels[channel] = channels[channel] + offset;
+
+        AudioBuffer<SampleType> block(blockChannels, numBlockChannels, num);
+        mProcessor.processBlock(block, mMidi);
+
+        mPlayHead.setPosition(mPlayHead.getTimeInSamples() + num);
+    }
+}
+
+//==============================================================================
+bool OfflineRenderer::isKnownSource(const String& source)
+{
+    return StringArray { "bypass", "silence", "noise", "beep" }.contains(source)
+        || File::getCurrentWorkingDirectory().getChildFile(source).existsAsFile();
+}
+
+
+bool OfflineRenderer::selectSource(RepeatorAudioProcessor& processor, const String& source)
+{
+    const int beepIndex = processor.mArrSelectOriginal.indexOf("beep");
+    const int builtInIndex = processor.mArrSelectOriginal.indexOf(source);
+
+    if(builtInIndex >= 0 && builtInIndex <= beepIndex)
+    {
+        processor.setSelection(builtInIndex);
+        processor.reloadSample();
+        return true;
+    }
+
+    if(! isKnownSource(source))
+        return false;
+
+    //a file goes in before "load..." like the editor does it
+    const File file = File::getCurrentWorkingDirectory().getChildFile(source);
+
+    processor.mFileName = file.getFileName();
+    processor.mArrSelect.insert(processor.mArrSelect.size() - 1, processor.mFileName);
+    processor.mArrPath.add(file.getFullPathName());
+
+    processor.setSelection(beepIndex + processor.mArrPath.size());
+    processor.reloadSample();
+    return true;
+}
+
+
+void OfflineRenderer::setParameter(RepeatorAudioProcessor& processor, const String& id, float value)
+{
+    if(auto* parameter = processor.mAPVTS.getParameter(id))
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 18 Oct 2026 10:02:44am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+
+//==============================================================================
+/**
+ A transport that always plays and advances by exactly the samples rendered.
+*/
+class OfflinePlayHead : public AudioPlayHead
+{
+public:
+    Optional<PositionInfo> getPosition() const override
+    {
+        PositionInfo info;
+        info.setIsPlaying(true);
+        info.setTimeInSamples(mTimeInSamples);
+        info.setTimeInSeconds(static_cast<double>(mTimeInSamples) / mSampleRate);
+
+        //a constant tempo and meter, like a project that never changes them
+        const double ppq = static_cast<double>(mTimeInSamples) / mSampleRate * mBpm / 60.;
+        const double barLength = 4. * mTimeSignature.numerator / mTimeSignature.denominator;
+        const double bars = std::floor(ppq / barLength);
+
+        info.setBpm(mBpm);
+        info.setTimeSignature(mTimeSignature);
+        info.setPpqPosition(ppq);
+        info.setPpqPositionOfLastBarStart(bars * barLength);
+        info.setBarCount(static_cast<int64>(bars));
+        return info;
+    }
+
+    void setSampleRate(double sampleRate) noexcept { mSampleRate = sampleRate; }
+    void setTempo(double bpm, int numerator, int denominator) noexcept { mBpm = bpm; mTimeSignature = { numerator, denominator }; }
+    void setPosition(int64 timeInSamples) noexcept { mTimeInSamples = timeInSamples; }
+    int64 getTimeInSamples() const noexcept { return mTimeInSamples; }
+
+private:
+    double mSampleRate = 44100.;
+    int64 mTimeInSamples = 0;
+    double mBpm = 120.;
+    TimeSignature mTimeSignature;
+};
+
+
+//==============================================================================
+/**
+ Drives a RepeatorAudioProcessor outside a host, the way a DAW bounce does.
+ Used by the command line tools and the benchmarks.
+*/
+class OfflineRenderer
+{
+public:
+    struct Settings
+    {
+        String source = "beep";     //bypass, silence, noise, beep or a file path
+        float periodInSec = 15.f;
+        float gainInDb = 0.f;
+        int blockSize = 4096;
+    };
+
+    OfflineRenderer(RepeatorAudioProcessor& processor);
+    ~OfflineRenderer();
+
+    //==============================================================================
+    /*
+     Sets the parameters and source, prepares the processor and waits for the
+     sample. False when the source is unknown, or when it should play a sample
+     and none could be loaded.
+     */
+    bool prepare(const Settings& settings, double sampleRate, int numChannels);
+
+    //processes buffer in place in blocks of at most Settings::blockSize
+    void process(AudioBuffer<float>& buffer);
+    void process(float* const* channels, int numChannels, int numSamples);
+
+    //the same in double precision, call setProcessingPrecision on the processor before prepare
+    void process(AudioBuffer<double>& buffer);
+    void process(double* const* channels, int numChannels, int numSamples);
+
+    void rewind() noexcept { mPlayHead.setPosition(0); }
+
+    //==============================================================================
+    //selects the source the same way the editor menu does, false when it is neither a built-in nor an existing file
+    static bool isKnownSource(const String& source);
+    static bool selectSource(RepeatorAudioProcessor& processor, const String& source);
+    static void setParameter(RepeatorAudioProcessor& processor, const String& id, float value);
+
+private:
+    template<typename SampleType>
+    void processBlocks(SampleType* const* channels, int numChannels, int numSamples);
+
+    RepeatorAudioProcessor& mProcessor;
+    OfflinePlayHead mPlayHead;
+    MidiBuffer mMidi;
+    int mBlockSize = 4096;
+
+    String mSource;
+
+    JUCE_DECLARE_NON_COPYABLE (OfflineRenderer)
+};
@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    WatermarkVerifier.cpp
+    Created: 19 Oct 2026 9:21:07am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#include "WatermarkVerifier.h"
+#include "SampleLoader.h"
+
+
+//==============================================================================
+WatermarkVerifier::WatermarkVerifier(const AudioBuffer<float>& source, double sampleRate)
+    : mTemplateLength(jmax(1, source.getNumSamples())),
+      mSampleRate(sampleRate)
+{
+    //at least twice the template so every block yields more lags than it overlaps
+    int order = 1;
+    while((1 << order) < 2 * mTemplateLength)
+        order++;
+
+    mFftSize = 1 << order;
+    mHopSize = mFftSize - mTemplateLength + 1;
+    mFft = std::make_unique<dsp::FFT>(order);
+
+    //conjugate spectrum of the zero-padded template
+    mTemplateSpectrum.calloc(static_cast<size_t>(2 * mFftSize));
+    if(source.getNumSamples() > 0)
+        FloatVectorOperations::copy(mTemplateSpectrum, source.getReadPointer(0), source.getNumSamples());
+
+    for(int i = 0; i < source.getNumSamples(); i++)
+        mTemplateEnergy += static_cast<double>(source.getSample(0, i)) * source.getSample(0, i);
+
+    mFft->performRealOnlyForwardTransform(mTemplateSpectrum);
+
+    for(int bin = 0; bin < mFftSize; bin++)
+        mTemplateSpectrum[2 * bin + 1] = -mTemplateSpectrum[2 * bin + 1];
+
+    //the template against itself must give its energy at lag 0, whatever the FFT scaling is
+    HeapBlock<float> block(static_cast<size_t>(2 * mFftSize), true);
+    HeapBlock<float> scores(static_cast<size_t>(mHopSize));
+
+    if(source.getNumSamples() > 0)
+        FloatVectorOperations::copy(block, source.getReadPointer(0), source.getNumSamples());
+
+    correlate(block, scores);
+
+    if(scores[0] != 0.f && mTemplateEnergy > 0.)
+        mCorrelationScale = static_cast<float>(mTemplateEnergy / scores[0]);
+}
+
+//==============================================================================
+void WatermarkVerifier::correlate(float* block, float* scores) const
+{
+    mFft->performRealOnlyForwardTransform(block);
+
+    for(int bin = 0; bin < mFftSize; bin++)
+    {
+        const float re = block[2 * bin], im = block[2 * bin + 1];
+        const float tRe = mTemplateSpectrum[2 * bin], tIm = mTemplateSpectrum[2 * bin + 1];
+
+        block[2 * bin]     = re * tRe - im * tIm;
+        block[2 * bin + 1] = re * tIm + im * tRe;
+    }
+
+    mFft->performRealOnlyInverseTransform(block);
+
+    //only the first hop lags are free of circular wrap-around
+    FloatVectorOperations::multiply(scores, block, mCorrelationScale, mHopSize);
+}
+
+
+WatermarkVerifier::Report WatermarkVerifier::verify(AudioFormatReader& reader, double periodInSec, float threshold) const
+{
+    auto report = detect(reader, threshold);
+
+    //the grid is anchored at the timeline's zero, the first trigger is a period later
+    std::vector<double> timesInSec;
+
+    if(periodInSec > 0.)
+        for(int64 index = 1; index * periodInSec <= report.durationInSec; index++)
+            timesInSec.push_back(index * periodInSec);
+
+    countMissing(report, timesInSec);
+    return report;
+}
+
+
+WatermarkVerifier::Report WatermarkVerifier::verify(AudioFormatReader& reader, const std::vector<double>& timesInSec, float threshold) const
+{
+    //the detections are matched in order, like the plugin keeps its list
+    auto sortedTimes = timesInSec;
+    std::sort(sortedTimes.begin(), sortedTimes.end());
+
+    auto report = detect(reader, threshold);
+    countMissing(report, sortedTimes);
+    return report;
+}
+
+
+WatermarkVerifier::Report WatermarkVerifier::detect(AudioFormatReader& reader, float threshold) const
+{
+    Report report;
+    report.durationInSec = reader.lengthInSamples / reader.sampleRate;
+
+    if(mTemplateEnergy <= 0. || reader.lengthInSamples < mTemplateLength)
+        return report;
+
+    const int numChannels = jmax(1, static_cast<int>(reader.numChannels));
+
+    AudioBuffer<float> readBuffer(numChannels, mHopSize);
+    HeapBlock<float> window(static_cast<size_t>(mFftSize), true);    //the current N samples, mono
+    HeapBlock<float> block(static_cast<size_t>(2 * mFftSize));
+    HeapBlock<float> scores(static_cast<size_t>(mHopSize));
+    HeapBlock<double> energy(static_cast<size_t>(mFftSize + 1));
+
+    const int64 numLags = reader.lengthInSamples - mTemplateLength + 1;
+    int64 windowStart = -static_cast<int64>(mFftSize - mHopSize); //the first hop fills the tail of the window
+
+    Detection pending;
+    int64 pendingLag = -1;
+
+    auto emitPending = [&]
+    {
+        if(pendingLag >= 0)
+            report.detections.add(pending);
+        pendingLag = -1;
+    };
+
+    while(windowStart + mFftSize - mTemplateLength < numLags)
+    {
+        //slide the window by one hop and read the next hop as mono
+        std::memmove(window, window + mHopSize, sizeof(float) * static_cast<size_t>(mFftSize - mHopSize));
+
+        const int64 readStart = windowStart + mFftSize;
+        const int numToRead = static_cast<int>(jlimit((int64) 0, (int64) mHopSize, reader.lengthInSamples - readStart));
+        float* newSamples = window + (mFftSize - mHopSize);
+
+        FloatVectorOperations::clear(newSamples, mHopSize);
+
+        if(numToRead > 0)
+        {
+            reader.read(&readBuffer, 0, numToRead, readStart, true, true);
+
+            for(int channel = 0; channel < numChannels; channel++)
+                FloatVectorOperations::addWithMultiply(newSamples, readBuffer.getReadPointer(channel), 1.f / numChannels, numToRead);
+        }
+
+        windowStart += mHopSize;
+
+        //sliding energy under the template for every lag in this window
+        energy[0] = 0.;
+        for(int i = 0; i < mFftSize; i++)
+            energy[i + 1] = energy[i] + static_cast<double>(window[i]) * window[i];
+
+        FloatVectorOperations::copy(block, window, mFftSize);
+        FloatVectorOperations::clear(block + mFftSize, mFftSize);
+        correlate(block, scores);
+
+        for(int n = 0; n < mHopSize; n++)
+        {
+            const int64 lag = windowStart + n;
+            if(lag < 0 || lag >= numLags)
+                continue;
+
+            const double windowEnergy = energy[n + mTemplateLength] - energy[n];
+            if(windowEnergy <= 1.0e-12)
+                continue;
+
+            const float correlation = static_cast<float>(scores[n] / std::sqrt(windowEnergy * mTemplateEnergy));
+
+            //a new peak needs to be at least one template length away from the last one
+            if(pendingLag >= 0 && lag - pendingLag >= mTemplateLength)
+                emitPending();
+
+            if(correlation >= threshold && (pendingLag < 0 || correlation > pending.correlation))
+            {
+                pendingLag = lag;
+                pending.timeInSec = lag / reader.sampleRate;
+                pending.correlation = correlation;
+                pending.levelInDb = Decibels::gainToDecibels(static_cast<float>(scores[n] / mTemplateEnergy));
+            }
+        }
+    }
+
+    emitPending();
+    return report;
+}
+
+
+void WatermarkVerifier::countMissing(Report& report, const std::vector<double>& timesInSec) const
+{
+    const double templateInSec = mTemplateLength / mSampleRate;
+    const double tolerance = 0.02;
+
+    int nextDetection = 0;
+
+    for(auto expected : timesInSec)
+    {
+        //a trigger too close to the end doesn't play all of the template
+        if(expected + templateInSec > report.durationInSec + tolerance)
+            continue;
+
+        report.numExpected++;
+
+        while(nextDetection < report.detections.size()
+              && report.detections.getReference(nextDetection).timeInSec < expected - tolerance)
+            nextDetection++;
+
+        if(nextDetection >= report.detections.size()
+           || report.detections.getReference(nextDetection).timeInSec > expected + tolerance)
+            report.numMissing++;
+    }
+}
+
+//==============================================================================
+AudioBuffer<float> WatermarkVerifier::loadSource(const String& source, double sampleRate)
+{
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    //read it whole, the verifier wants the complete template
+    SampleLoader loader(formatManager);
+    loader.setStreamingThreshold(std::numeric_limits<float>::max());
+
+    if(source == "beep")
+        loader.loadBeep(sampleRate, 2);
+    else
+        loader.loadFile(File::getCurrentWorkingDirectory().getChildFile(source), sampleRate, 2);
+
+    loader.waitUntilIdle(60000);
+    loader.updateCurrentSample();
+
+    auto* sample = loader.getCurrentSample();
+    if(sample == nullptr)
+        return {};
+
+    AudioBuffer<float> stereo(2, sample->getLengthInSamples());
+    sample->readSamples(stereo.getArrayOfWritePointers(), 2, 0, sample->getLengthInSamples());
+
+    //the same mono mixdown verify() uses for the file
+    AudioBuffer<float> mono(1, stereo.getNumSamples());
+    mono.copyFrom(0, 0, stereo, 0, 0, stereo.getNumSamples(), 0.5f);
+    mono.addFrom(0, 0, stereo, 1, 0, stereo.getNumSamples(), 0.5f);
+
+    return mono;
+}
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    WatermarkVerifier.h
+    Created: 19 Oct 2026 9:21:07am
+    Author:  Voyagers Audio
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+//==============================================================================
+/**
+ Finds every occurrence of the watermark in a rendered file.
+
+ The file is scanned once with an overlap-save FFT cross-correlation against
+ the source, normalised by the energy under the template so the score is a
+ correlation coefficient. Peaks above the threshold are the detected triggers.
+*/
+class WatermarkVerifier
+{
+public:
+    struct Detection
+    {
+        double timeInSec = 0.;
+        float correlation = 0.f;    //0..1, how much of the signal the watermark explains
+        float levelInDb = 0.f;      //gain of the watermark relative to the source
+    };
+
+    struct Report
+    {
+        Array<Detection> detections;
+        double durationInSec = 0.;
+        int numExpected = 0;
+        int numMissing = 0;
+
+        bool passed() const noexcept { return numExpected > 0 && numMissing == 0; }
+    };
+
+    //==============================================================================
+    //source is the watermark as the plugin plays it, mono, at sampleRate
+    WatermarkVerifier(const AudioBuffer<float>& source, double sampleRate);
+
+    /*
+     Scans the whole reader of a render that started at the timeline's zero.
+     Grid triggers are expected every periodInSec from zero, list triggers at
+     the given times. Any expected trigger without a detection within 20 ms
+     counts as missing. Jitter and bars schedules can't be checked this way,
+     their times depend on the seed or on the host's tempo.
+     */
+    Report verify(AudioFormatReader& reader, double periodInSec, float threshold = 0.3f) const;
+    Report verify(AudioFormatReader& reader, const std::vector<double>& timesInSec, float threshold = 0.3f) const;
+
+    //the beep or a file as SampleLoader would load it for sampleRate, mono
+    static AudioBuffer<float> loadSource(const String& source, double sampleRate);
+
+private:
+    //==============================================================================
+    void correlate(float* block, float* scores) const;
+    Report detect(AudioFormatReader& reader, float threshold) const;
+    void countMissing(Report& report, const std::vector<double>& timesInSec) const;
+
+    int mTemplateLength = 0;
+    int mFftSize = 0;
+    int mHopSize = 0;
+    double mSampleRate = 0.;
+    double mTemplateEnergy = 0.;
+
+    std::unique_ptr<dsp::FFT> mFft;
+    HeapBlock<float> mTemplateSpectrum;
+    float mCorrelationScale = 1.f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WatermarkVerifier)
+};
@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 11:14:20am
+    Author:  Voyagers Audio
+
+    repeator-batch: watermarks every audio file in a directory tree with the
+    same engine the plugin uses, one file per core at a time.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Common/OfflineRenderer.h"
+
+
+namespace
+{
+    const char* usage =
+        "usage: repeator-batch <inputDir> <outputDir> [options]\n"
+        "\n"
+        "  --source=<beep|noise|silence|file>  what to play on each trigger (default beep)\n"
+        "  --period=<seconds>                  time between triggers (default 15)\n"
+        "  --gain=<dB>                         watermark gain, -30 to 12 (default 0)\n"
+        "  --threads=<n>                       worker threads (default: all cores)\n"
+        "  --block=<samples>                   processing block size (default 4096)\n"
+        "\n"
+        "WAV, AIFF and FLAC files keep their format, everything else is written as WAV.\n";
+
+    //lossless formats written back in the same format, anything else, lossy inputs included, becomes WAV
+    const StringArray writableExtensions { ".wav", ".aif", ".aiff", ".flac" };
+
+    //==============================================================================
+    struct BatchStats
+    {
+        std::atomic<int> numDone { 0 };
+        std::atomic<int> numFailed { 0 };
+        std::atomic<int64> numFrames { 0 };
+        std::atomic<int64> audioMicroseconds { 0 };
+    };
+
+    //==============================================================================
+    class BatchWorker : public ThreadPoolJob
+    {
+    public:
+        BatchWorker(const Array<File>& inputs, const File& inputDir, const File& outputDir,
+                    std::atomic<int>& nextFile, BatchStats& stats, const OfflineRenderer::Settings& settings)
+            : ThreadPoolJob("repeator-batch worker"),
+              mInputs(inputs), mInputDir(inputDir), mOutputDir(outputDir),
+              mNextFile(nextFile), mStats(stats), mSettings(settings)
+        {
+            mFormatManager.registerBasicFormats();
+        }
+
+        JobStatus runJob() override
+        {
+            for(int index = mNextFile++; index < mInputs.size() && ! shouldExit(); index = mNextFile++)
+            {
+                const File& input = mInputs.getReference(index);
+
+                if(processFile(input))
+                    mStats.numDone++;
+                else
+                {
+                    mStats.numFailed++;
+                    std::cerr << "failed: " << input.getFullPathName() << std::endl;
+                }
+            }
+
+            return jobHasFinished;
+        }
+
+    private:
+        //==============================================================================
+        File getOutputFile(const File& input) const
+        {
+            File output = mOutputDir.getChildFile(input.getRelativePathFrom(mInputDir));
+
+            if(! writableExtensions.contains(output.getFileExtension(), true))
+                output = output.withFileExtension("wav");
+
+            return output;
+        }
+
+        bool processFile(const File& input)
+        {
+            std::unique_ptr<AudioFormatReader> reader(mFormatManager.createReaderFor(input));
+            if(reader == nullptr || reader->numChannels == 0)
+                return false;
+
+            const File output = getOutputFile(input);
+            auto* format = mFormatManager.findFormatForFileExtension(output.getFileExtension());
+            if(format == nullptr || ! output.getParentDirectory().createDirectory())
+                return false;
+
+            //before the output is created, so a failed load leaves no file behind
+            if(! mRenderer.prepare(mSettings, reader->sampleRate, static_cast<int>(reader->numChannels)))
+                return false;
+
+            output.deleteFile();
+            auto stream = std::make_unique<FileOutputStream>(output);
+            if(stream->failedToOpen())
+                return false;
+
+            int bitsPerSample = static_cast<int>(reader->bitsPerSample);
+            if(! format->getPossibleBitDepths().contains(bitsPerSample))
+                bitsPerSample = format->getPossibleBitDepths().contains(24) ? 24 : format->getPossibleBitDepths().getLast();
+
+            const int numChannels = static_cast<int>(reader->numChannels);
+            std::unique_ptr<AudioFormatWriter> writer(format->createWriterFor(stream.get(), reader->sampleRate,
+                                                                              reader->numChannels, bitsPerSample,
+                                                                              reader->metadataValues, 0));
+            if(writer == nullptr)
+                return false;
+
+            stream.release(); //the writer owns it now
+
+            //decode, process and encode one block at a time, nothing is held for the whole file
+            AudioBuffer<float> block(numChannels, mSettings.blockSize);
+
+            for(int64 position = 0; position < reader->lengthInSamples; position += mSettings.blockSize)
+            {
+                if(shouldExit())
+                    return false;
+
+                const int numSamples = static_cast<int>(jmin(static_cast<int64>(mSettings.blockSize), reader->lengthInSamples - position));
+
+                reader->read(&block, 0, numSamples, position, true, true);
+                mRenderer.process(block.getArrayOfWritePointers(), numChannels, numSamples);
+
+                if(! writer->writeFromAudioSampleBuffer(block, 0, numSamples))
+                    return false;
+            }
+
+            mStats.numFrames += reader->lengthInSamples;
+            mStats.audioMicroseconds += static_cast<int64>(1.0e6 * reader->lengthInSamples / reader->sampleRate);
+            return true;
+        }
+
+        //==============================================================================
+        const Array<File>& mInputs;
+        const File mInputDir, mOutputDir;
+        std::atomic<int>& mNextFile;
+        BatchStats& mStats;
+        const OfflineRenderer::Settings mSettings;
+
+        AudioFormatManager mFormatManager;
+
+        //processors set the global translation mappings, so workers are made on the main thread
+        RepeatorAudioProcessor mProcessor;
+        OfflineRenderer mRenderer { mProcessor };
+    };
+}
+
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ArgumentList args(argc, argv);
+
+    if(args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    StringArray positional;
+    for(auto& argument : args.arguments)
+        if(! argument.isOption())
+            positional.add(argument.text);
+
+    if(positional.size() != 2)
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    const File inputDir = File::getCurrentWorkingDirectory().getChildFile(positional[0]);
+    const File outputDir = File::getCurrentWorkingDirectory().getChildFile(positional[1]);
+
+    if(! inputDir.isDirectory())
+    {
+        std::cerr << "not a directory: " << inputDir.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    OfflineRenderer::Settings settings;
+    if(args.containsOption("--source"))  settings.source = args.getValueForOption("--source");
+    if(args.containsOption("--period"))  settings.periodInSec = args.getValueForOption("--period").getFloatValue();
+    if(args.containsOption("--gain"))    settings.gainInDb = args.getValueForOption("--gain").getFloatValue();
+    if(args.containsOption("--block"))   settings.blockSize = jmax(16, args.getValueForOption("--block").getIntValue());
+
+    if(! OfflineRenderer::isKnownSource(settings.source))
+    {
+        std::cerr << "unknown source " << settings.source << ", not a built-in or an existing file" << std::endl;
+        return 1;
+    }
+
+    int numThreads = SystemStats::getNumCpus();
+    if(args.containsOption("--threads"))
+        numThreads = jmax(1, args.getValueForOption("--threads").getIntValue());
+
+    //==============================================================================
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    Array<File> inputs = inputDir.findChildFiles(File::findFiles, true, formatManager.getWildcardForAllFormats());
+    inputs.sort();
+
+    //the output tree must not be scanned again if it sits inside the input tree
+    inputs.removeIf([&outputDir] (const File& file) { return file.isAChildOf(outputDir); });
+
+    numThreads = jmin(numThreads, jmax(1, inputs.size()));
+
+    std::cout << "repeator-batch: " << inputs.size() << " files, " << numThreads << " threads" << std::endl;
+
+    //==============================================================================
+    std::atomic<int> nextFile { 0 };
+    BatchStats stats;
+
+    ThreadPool pool(numThreads);
+    OwnedArray<BatchWorker> workers;
+
+    for(int i = 0; i < numThreads; i++)
+        workers.add(new BatchWorker(inputs, inputDir, outputDir, nextFile, stats, settings));
+
+    const double startTime = Time::getMillisecondCounterHiRes();
+
+    for(auto* worker : workers)
+        pool.addJob(worker, false);
+
+    while(pool.getNumJobs() > 0)
+    {
+        Thread::sleep(1000);
+        std::cout << "\r" << (stats.numDone.load() + stats.numFailed.load()) << "/" << inputs.size() << std::flush;
+    }
+
+    const double wallSeconds = jmax(1.0e-6, (Time::getMillisecondCounterHiRes() - startTime) / 1000.0);
+    const double audioSeconds = stats.audioMicroseconds.load() / 1.0e6;
+
+    std::cout << "\r" << stats.numDone.load() << " done, " << stats.numFailed.load() << " failed in "
+              << String(wallSeconds, 2) << " s" << std::endl
+              << String(stats.numDone.load() / wallSeconds, 2) << " files/s, "
+              << String(audioSeconds / wallSeconds, 1) << "x realtime, "
+              << String(stats.numFrames.load() / wallSeconds / 1.0e6, 2) << " Mframes/s" << std::endl;
+
+    return stats.numFailed.load() == 0 ? 0 : 2;
+}
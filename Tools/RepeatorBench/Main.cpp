@@ -0,0 +1,375 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 21 Oct 2026 10:05:37am
+    Author:  Voyagers Audio
+
+    repeator-bench: times processBlock for every source, block size, sample
+    rate and channel count, without a host or an audio device.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Common/OfflineRenderer.h"
+
+
+namespace
+{
+    const char* usage =
+        "usage: repeator-bench [options]\n"
+        "\n"
+        "  --sources=<list>      bypass, silence, noise, beep and file (default: all but file)\n"
+        "  --file=<path>         the sample for the file source, adds it to the default sources\n"
+        "  --blocks=<list>       block sizes (default 16,64,256,1024,4096)\n"
+        "  --rates=<list>        sample rates (default 44100,48000,96000,192000)\n"
+        "  --channels=<list>     channel counts (default 1,2,8)\n"
+        "  --precision=<list>    float and/or double (default float)\n"
+        "  --bit-depth=<16|24|32>  how decoded samples are held, 16 and 24 compressed (default 32, float)\n"
+        "  --seconds=<seconds>   audio timed per case (default 5)\n"
+        "  --max-ns=<ns>         fails when a case's p99 goes over this many ns per sample frame\n"
+        "  --period=<seconds>    time between triggers (default 1)\n"
+        "  --format=<table|csv|json>  output format (default table)\n"
+        "  --output=<file>       writes the results there instead of stdout\n"
+        "\n"
+        "lists are comma separated, e.g. --blocks=64,512 --rates=48000\n";
+
+    //==============================================================================
+    struct BenchCase
+    {
+        String source;
+        int blockSize;
+        double sampleRate;
+        int numChannels;
+        bool isDoublePrecision;
+    };
+
+    struct BenchResult
+    {
+        BenchCase benchCase;
+        int numBlocks = 0;
+
+        //nanoseconds per sample frame, over all blocks
+        double mean = 0., p50 = 0., p90 = 0., p99 = 0., max = 0.;
+
+        //audio time over processing time
+        double realtimeFactor = 0.;
+
+        //the slowest block as a fraction of its own duration, what makes a host drop out
+        double peakLoad = 0.;
+    };
+
+    //==============================================================================
+    StringArray getList(const ArgumentList& args, const String& option, const String& defaultValue)
+    {
+        const String value = args.containsOption(option) ? args.getValueForOption(option) : defaultValue;
+
+        auto list = StringArray::fromTokens(value, ",", {});
+        list.trim();
+        list.removeEmptyStrings();
+        return list;
+    }
+
+    //nearest rank on sorted values
+    double getPercentile(const std::vector<double>& sorted, double percentile)
+    {
+        const auto rank = static_cast<size_t>(std::ceil(percentile / 100. * static_cast<double>(sorted.size())));
+        return sorted[jlimit<size_t>(0, sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+    }
+
+    //==============================================================================
+    template<typename SampleType>
+    bool runCase(RepeatorAudioProcessor& processor, OfflineRenderer& renderer, const OfflineRenderer::Settings& settings,
+                 double secondsPerCase, BenchResult& result)
+    {
+        const auto& benchCase = result.benchCase;
+        const int numChannels = benchCase.numChannels;
+        const int blockSize = benchCase.blockSize;
+
+        processor.setProcessingPrecision(benchCase.isDoublePrecision ? AudioProcessor::doublePrecision
+                                                                     : AudioProcessor::singlePrecision);
+
+        if(! renderer.prepare(settings, benchCase.sampleRate, numChannels))
+            return false;
+
+        //a quiet sine, the same for every block, copied in outside the timed section
+        AudioBuffer<SampleType> input(numChannels, blockSize);
+        for(int channel = 0; channel < numChannels; channel++)
+            for(int i = 0; i < blockSize; i++)
+                input.setSample(channel, i, static_cast<SampleType>(0.01 * std::sin(0.05 * (i + channel))));
+
+        AudioBuffer<SampleType> block(numChannels, blockSize);
+
+        const int numBlocks = jmax(64, roundToInt(secondsPerCase * benchCase.sampleRate / blockSize));
+        const int numWarmUpBlocks = jmax(8, numBlocks / 20);
+
+        std::vector<double> nsPerSample;
+        nsPerSample.reserve(static_cast<size_t>(numBlocks));
+
+        const double nsPerTick = 1.0e9 / static_cast<double>(Time::getHighResolutionTicksPerSecond());
+        double totalNs = 0., maxBlockNs = 0.;
+
+        renderer.rewind();
+
+        for(int index = 0; index < numWarmUpBlocks + numBlocks; index++)
+        {
+            block.makeCopyOf(input, true);
+
+            const int64 start = Time::getHighResolutionTicks();
+            renderer.process(block);
+            const int64 end = Time::getHighResolutionTicks();
+
+            if(index < numWarmUpBlocks)
+                continue;
+
+            const double blockNs = static_cast<double>(end - start) * nsPerTick;
+            nsPerSample.push_back(blockNs / blockSize);
+            totalNs += blockNs;
+            maxBlockNs = jmax(maxBlockNs, blockNs);
+        }
+
+        std::sort(nsPerSample.begin(), nsPerSample.end());
+
+        const double audioNs = 1.0e9 * numBlocks * blockSize / benchCase.sampleRate;
+        const double blockDurationNs = 1.0e9 * blockSize / benchCase.sampleRate;
+
+        result.numBlocks = numBlocks;
+        result.mean = totalNs / (static_cast<double>(numBlocks) * blockSize);
+        result.p50 = getPercentile(nsPerSample, 50.);
+        result.p90 = getPercentile(nsPerSample, 90.);
+        result.p99 = getPercentile(nsPerSample, 99.);
+        result.max = nsPerSample.back();
+        result.realtimeFactor = audioNs / jmax(1., totalNs);
+        result.peakLoad = maxBlockNs / blockDurationNs;
+        return true;
+    }
+
+    //==============================================================================
+    String toTable(const std::vector<BenchResult>& results, int bitDepth)
+    {
+        String text;
+        text << String("source").paddedRight(' ', 10) << String("block").paddedLeft(' ', 6) << String("rate").paddedLeft(' ', 8)
+             << String("ch").paddedLeft(' ', 4) << String("prec").paddedLeft(' ', 7)
+             << String("mean").paddedLeft(' ', 9) << String("p50").paddedLeft(' ', 9) << String("p90").paddedLeft(' ', 9)
+             << String("p99").paddedLeft(' ', 9) << String("max").paddedLeft(' ', 10)
+             << String("x realtime").paddedLeft(' ', 12) << String("peak load").paddedLeft(' ', 11) << "\n";
+
+        for(auto& result : results)
+        {
+            const auto& benchCase = result.benchCase;
+
+            text << benchCase.source.paddedRight(' ', 10) << String(benchCase.blockSize).paddedLeft(' ', 6)
+                 << String(roundToInt(benchCase.sampleRate)).paddedLeft(' ', 8) << String(benchCase.numChannels).paddedLeft(' ', 4)
+                 << String(benchCase.isDoublePrecision ? "double" : "float").paddedLeft(' ', 7)
+                 << String(result.mean, 2).paddedLeft(' ', 9) << String(result.p50, 2).paddedLeft(' ', 9)
+                 << String(result.p90, 2).paddedLeft(' ', 9) << String(result.p99, 2).paddedLeft(' ', 9)
+                 << String(result.max, 2).paddedLeft(' ', 10) << String(result.realtimeFactor, 1).paddedLeft(' ', 12)
+                 << (String(result.peakLoad * 100., 2) + "%").paddedLeft(' ', 11) << "\n";
+        }
+
+        text << "\ntimes are ns per sample frame, peak load is the slowest block over its duration\n"
+             << "samples held " << (bitDepth == 0 ? String("as float") : "compressed at " + String(bitDepth) + " bit") << "\n";
+        return text;
+    }
+
+
+    String toCsv(const std::vector<BenchResult>& results)
+    {
+        String text = "source,block_size,sample_rate,channels,precision,blocks,mean_ns,p50_ns,p90_ns,p99_ns,max_ns,realtime_factor,peak_load\n";
+
+        for(auto& result : results)
+        {
+            const auto& benchCase = result.benchCase;
+
+            text << benchCase.source << "," << benchCase.blockSize << "," << benchCase.sampleRate << ","
+                 << benchCase.numChannels << "," << (benchCase.isDoublePrecision ? "double" : "float") << ","
+                 << result.numBlocks << "," << result.mean << "," << result.p50 << "," << result.p90 << ","
+                 << result.p99 << "," << result.max << "," << result.realtimeFactor << "," << result.peakLoad << "\n";
+        }
+
+        return text;
+    }
+
+
+    String toJson(const std::vector<BenchResult>& results, int bitDepth)
+    {
+        DynamicObject::Ptr system = new DynamicObject();
+        system->setProperty("cpu", SystemStats::getCpuModel());
+        system->setProperty("cpus", SystemStats::getNumCpus());
+        system->setProperty("os", SystemStats::getOperatingSystemName());
+        system->setProperty("juce", SystemStats::getJUCEVersion());
+
+        Array<var> cases;
+
+        for(auto& result : results)
+        {
+            const auto& benchCase = result.benchCase;
+
+            DynamicObject::Ptr object = new DynamicObject();
+            object->setProperty("source", benchCase.source);
+            object->setProperty("blockSize", benchCase.blockSize);
+            object->setProperty("sampleRate", benchCase.sampleRate);
+            object->setProperty("channels", benchCase.numChannels);
+            object->setProperty("precision", benchCase.isDoublePrecision ? "double" : "float");
+            object->setProperty("blocks", result.numBlocks);
+            object->setProperty("meanNs", result.mean);
+            object->setProperty("p50Ns", result.p50);
+            object->setProperty("p90Ns", result.p90);
+            object->setProperty("p99Ns", result.p99);
+            object->setProperty("maxNs", result.max);
+            object->setProperty("realtimeFactor", result.realtimeFactor);
+            object->setProperty("peakLoad", result.peakLoad);
+            cases.add(var(object.get()));
+        }
+
+        DynamicObject::Ptr root = new DynamicObject();
+        root->setProperty("version", ProjectInfo::versionString);
+        root->setProperty("date", Time::getCurrentTime().toISO8601(true));
+        root->setProperty("system", var(system.get()));
+        root->setProperty("bitDepth", bitDepth == 0 ? 32 : bitDepth);
+        root->setProperty("results", cases);
+
+        return JSON::toString(var(root.get())) + "\n";
+    }
+}
+
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ArgumentList args(argc, argv);
+
+    if(args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    const String filePath = args.containsOption("--file") ? args.getValueForOption("--file") : String();
+
+    const StringArray sources = getList(args, "--sources", filePath.isNotEmpty() ? "bypass,silence,noise,beep,file"
+                                                                                 : "bypass,silence,noise,beep");
+    const StringArray blockSizes = getList(args, "--blocks", "16,64,256,1024,4096");
+    const StringArray sampleRates = getList(args, "--rates", "44100,48000,96000,192000");
+    const StringArray channelCounts = getList(args, "--channels", "1,2,8");
+    const StringArray precisions = getList(args, "--precision", "float");
+
+    const double secondsPerCase = args.containsOption("--seconds") ? jmax(0.1, args.getValueForOption("--seconds").getDoubleValue()) : 5.;
+    const String format = args.containsOption("--format") ? args.getValueForOption("--format") : String("table");
+    const double maxNs = args.containsOption("--max-ns") ? args.getValueForOption("--max-ns").getDoubleValue() : 0.;
+
+    if(sources.contains("file") && filePath.isEmpty())
+    {
+        std::cerr << "the file source needs --file" << std::endl;
+        return 1;
+    }
+
+    if(format != "table" && format != "csv" && format != "json")
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    //32 is plain float, the loader's 0
+    const int bitDepthOption = args.containsOption("--bit-depth") ? args.getValueForOption("--bit-depth").getIntValue() : 32;
+    if(bitDepthOption != 16 && bitDepthOption != 24 && bitDepthOption != 32)
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    const int bitDepth = bitDepthOption == 32 ? 0 : bitDepthOption;
+
+    OfflineRenderer::Settings settings;
+    settings.periodInSec = args.containsOption("--period") ? args.getValueForOption("--period").getFloatValue() : 1.f;
+
+    //==============================================================================
+    std::vector<BenchCase> benchCases;
+
+    for(auto& source : sources)
+        for(auto& precision : precisions)
+            for(auto& channels : channelCounts)
+                for(auto& rate : sampleRates)
+                    for(auto& block : blockSizes)
+                        benchCases.push_back({ source, jlimit(1, 1 << 16, block.getIntValue()), rate.getDoubleValue(),
+                                               jlimit(1, static_cast<int>(ChannelMatrix::maxChannels), channels.getIntValue()),
+                                               precision == "double" });
+
+    //one processor for everything, the same way a host reconfigures a plugin
+    RepeatorAudioProcessor processor;
+    processor.setCompressedBitDepth(bitDepth);
+    OfflineRenderer renderer(processor);
+
+    std::vector<BenchResult> results;
+    int numFailed = 0;
+
+    for(size_t index = 0; index < benchCases.size(); index++)
+    {
+        const auto& benchCase = benchCases[index];
+
+        settings.source = benchCase.source == "file" ? filePath : benchCase.source;
+        settings.blockSize = benchCase.blockSize;
+
+        std::cerr << "\r" << (index + 1) << "/" << benchCases.size() << " " << benchCase.source << " " << benchCase.blockSize
+                  << " " << benchCase.sampleRate << " Hz " << benchCase.numChannels << " ch        " << std::flush;
+
+        BenchResult result;
+        result.benchCase = benchCase;
+
+        const bool ok = benchCase.isDoublePrecision ? runCase<double>(processor, renderer, settings, secondsPerCase, result)
+                                                    : runCase<float>(processor, renderer, settings, secondsPerCase, result);
+        if(ok)
+            results.push_back(result);
+        else
+        {
+            numFailed++;
+            std::cerr << "\nfailed to prepare " << benchCase.source << std::endl;
+        }
+    }
+
+    std::cerr << std::endl;
+
+    //==============================================================================
+    const String report = format == "json" ? toJson(results, bitDepth)
+                        : format == "csv"  ? toCsv(results)
+                                           : toTable(results, bitDepth);
+
+    if(args.containsOption("--output"))
+    {
+        const File output = args.getFileForOption("--output");
+        if(! output.replaceWithText(report))
+        {
+            std::cerr << "can't write " << output.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << report;
+    }
+
+    //a limit on the cost, e.g. of decoding compressed samples, for use in CI
+    int numOverLimit = 0;
+
+    if(maxNs > 0.)
+    {
+        for(auto& result : results)
+        {
+            if(result.p99 > maxNs)
+            {
+                numOverLimit++;
+                std::cerr << "over the limit: " << result.benchCase.source << " " << result.benchCase.blockSize << " "
+                          << result.benchCase.sampleRate << " Hz " << result.benchCase.numChannels << " ch, p99 "
+                          << String(result.p99, 2) << " ns > " << String(maxNs, 2) << " ns" << std::endl;
+            }
+        }
+    }
+
+    if(numFailed > 0)
+        return 2;
+
+    return numOverLimit == 0 ? 0 : 3;
+}
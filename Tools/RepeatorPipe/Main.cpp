@@ -0,0 +1,322 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 2:40:51pm
+    Author:  Voyagers Audio
+
+    repeator-pipe: watermarks a PCM stream from stdin to stdout block by block,
+    so ffmpeg pipelines can process streams of any length in constant memory.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Common/OfflineRenderer.h"
+
+#include <cstdio>
+
+
+namespace
+{
+    const char* usage =
+        "usage: repeator-pipe [options] < input > output\n"
+        "\n"
+        "  --format=<f32le|s16le|wav>          input format (default f32le)\n"
+        "  --out-format=<f32le|s16le|wav>      output format (default: same as input)\n"
+        "  --rate=<Hz>                         sample rate of raw input (default 48000)\n"
+        "  --channels=<n>                      channels of raw input (default 2)\n"
+        "  --source=<beep|noise|silence|file>  what to play on each trigger (default beep)\n"
+        "  --period=<seconds>                  time between triggers (default 15)\n"
+        "  --gain=<dB>                         watermark gain, -30 to 12 (default 0)\n"
+        "  --block=<frames>                    frames per block, also the latency (default 4096)\n"
+        "  --stats                             print throughput to stderr at the end\n"
+        "\n"
+        "example: ffmpeg -i in.mov -f f32le - | repeator-pipe --rate=48000 --channels=2 | ffmpeg -f f32le -ar 48000 -ac 2 -i - out.wav\n";
+
+    enum class SampleFormat { f32, s16, s24 };
+
+    int getBytesPerSample(SampleFormat format) noexcept
+    {
+        return format == SampleFormat::f32 ? 4 : (format == SampleFormat::s24 ? 3 : 2);
+    }
+
+    //==============================================================================
+    bool readExactly(void* dest, size_t numBytes)
+    {
+        return std::fread(dest, 1, numBytes, stdin) == numBytes;
+    }
+
+    //reads and drops numBytes through a fixed buffer, however large the stream claims the chunk is
+    bool skipExactly(uint64 numBytes)
+    {
+        uint8 buffer[4096];
+
+        while(numBytes > 0)
+        {
+            const auto num = static_cast<size_t>(jmin(numBytes, static_cast<uint64>(sizeof(buffer))));
+            if(! readExactly(buffer, num))
+                return false;
+
+            numBytes -= num;
+        }
+
+        return true;
+    }
+
+    uint32 readLittleEndian32(const uint8* data) noexcept { return ByteOrder::littleEndianInt(data); }
+    uint16 readLittleEndian16(const uint8* data) noexcept { return ByteOrder::littleEndianShort(data); }
+
+    /*
+     Reads a WAV header up to the start of the sample data. Only the chunks in
+     front of "data" are consumed, the rest is streamed.
+     */
+    bool readWavHeader(double& sampleRate, int& numChannels, SampleFormat& format)
+    {
+        uint8 riff[12];
+        if(! readExactly(riff, 12) || std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0)
+            return false;
+
+        bool hasFormat = false;
+
+        for(;;)
+        {
+            uint8 chunkHeader[8];
+            if(! readExactly(chunkHeader, 8))
+                return false;
+
+            const uint32 chunkSize = readLittleEndian32(chunkHeader + 4);
+
+            if(std::memcmp(chunkHeader, "data", 4) == 0)
+                return hasFormat;
+
+            //chunks are padded to an even size
+            const uint64 paddedSize = static_cast<uint64>(chunkSize) + (chunkSize & 1);
+
+            //only "fmt " is kept, anything else in front of the data is skipped
+            if(std::memcmp(chunkHeader, "fmt ", 4) != 0)
+            {
+                if(! skipExactly(paddedSize))
+                    return false;
+
+                continue;
+            }
+
+            //a real format chunk is 16 to 40 bytes
+            constexpr uint32 maxFormatSize = 256;
+            if(chunkSize < 16 || chunkSize > maxFormatSize)
+                return false;
+
+            uint8 chunk[maxFormatSize + 1];
+            if(! readExactly(chunk, static_cast<size_t>(paddedSize)))
+                return false;
+
+            uint16 formatTag = readLittleEndian16(chunk);
+            numChannels = readLittleEndian16(chunk + 2);
+            sampleRate = readLittleEndian32(chunk + 4);
+            const int bitsPerSample = readLittleEndian16(chunk + 14);
+
+            //WAVE_FORMAT_EXTENSIBLE keeps the real tag in the sub-format GUID
+            if(formatTag == 0xfffe && chunkSize >= 26)
+                formatTag = readLittleEndian16(chunk + 24);
+
+            if(formatTag == 3 && bitsPerSample == 32)        format = SampleFormat::f32;
+            else if(formatTag == 1 && bitsPerSample == 16)   format = SampleFormat::s16;
+            else if(formatTag == 1 && bitsPerSample == 24)   format = SampleFormat::s24;
+            else return false;
+
+            hasFormat = true;
+        }
+    }
+
+    //the size fields are left at their maximum since the length isn't known up front
+    void writeWavHeader(double sampleRate, int numChannels, SampleFormat format)
+    {
+        const int bytesPerSample = getBytesPerSample(format);
+        MemoryOutputStream header;
+
+        header.write("RIFF", 4);
+        header.writeInt(-1);
+        header.write("WAVE", 4);
+        header.write("fmt ", 4);
+        header.writeInt(16);
+        header.writeShort(static_cast<short>(format == SampleFormat::f32 ? 3 : 1));
+        header.writeShort(static_cast<short>(numChannels));
+        header.writeInt(static_cast<int>(sampleRate));
+        header.writeInt(static_cast<int>(sampleRate) * numChannels * bytesPerSample);
+        header.writeShort(static_cast<short>(numChannels * bytesPerSample));
+        header.writeShort(static_cast<short>(bytesPerSample * 8));
+        header.write("data", 4);
+        header.writeInt(-1);
+
+        std::fwrite(header.getData(), 1, header.getDataSize(), stdout);
+    }
+
+    //==============================================================================
+    void deinterleave(const uint8* source, SampleFormat format, float* const* dest, int numChannels, int numFrames)
+    {
+        const int bytesPerSample = getBytesPerSample(format);
+        const int frameBytes = numChannels * bytesPerSample;
+
+        for(int channel = 0; channel < numChannels; channel++)
+        {
+            const uint8* channelSource = source + channel * bytesPerSample;
+
+            if(format == SampleFormat::f32)
+                AudioDataConverters::convertFloat32LEToFloat(channelSource, dest[channel], numFrames, frameBytes);
+            else if(format == SampleFormat::s16)
+                AudioDataConverters::convertInt16LEToFloat(channelSource, dest[channel], numFrames, frameBytes);
+            else
+                AudioDataConverters::convertInt24LEToFloat(channelSource, dest[channel], numFrames, frameBytes);
+        }
+    }
+
+    void interleave(const float* const* source, int numChannels, SampleFormat format, uint8* dest, int numFrames)
+    {
+        const int bytesPerSample = getBytesPerSample(format);
+        const int frameBytes = numChannels * bytesPerSample;
+
+        for(int channel = 0; channel < numChannels; channel++)
+        {
+            uint8* channelDest = dest + channel * bytesPerSample;
+
+            if(format == SampleFormat::f32)
+                AudioDataConverters::convertFloatToFloat32LE(source[channel], channelDest, numFrames, frameBytes);
+            else if(format == SampleFormat::s16)
+                AudioDataConverters::convertFloatToInt16LE(source[channel], channelDest, numFrames, frameBytes);
+            else
+                AudioDataConverters::convertFloatToInt24LE(source[channel], channelDest, numFrames, frameBytes);
+        }
+    }
+
+    bool parseFormat(const String& text, SampleFormat& format, bool& isWav)
+    {
+        isWav = text == "wav";
+
+        if(text == "f32le" || isWav)   { format = SampleFormat::f32; return true; }
+        if(text == "s16le")            { format = SampleFormat::s16; return true; }
+        return false;
+    }
+}
+
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ArgumentList args(argc, argv);
+
+    if(args.containsOption("--help|-h"))
+    {
+        std::cerr << usage;
+        return 0;
+    }
+
+    SampleFormat inFormat = SampleFormat::f32;
+    bool isWavIn = false;
+    if(args.containsOption("--format") && ! parseFormat(args.getValueForOption("--format"), inFormat, isWavIn))
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    double sampleRate = 48000.;
+    int numChannels = 2;
+    if(args.containsOption("--rate"))      sampleRate = args.getValueForOption("--rate").getDoubleValue();
+    if(args.containsOption("--channels"))  numChannels = args.getValueForOption("--channels").getIntValue();
+
+    if(isWavIn && ! readWavHeader(sampleRate, numChannels, inFormat))
+    {
+        std::cerr << "repeator-pipe: unsupported or broken WAV header" << std::endl;
+        return 1;
+    }
+
+    SampleFormat outFormat = inFormat;
+    bool isWavOut = isWavIn;
+    if(args.containsOption("--out-format") && ! parseFormat(args.getValueForOption("--out-format"), outFormat, isWavOut))
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    if(sampleRate <= 0. || numChannels <= 0 || numChannels > 64)
+    {
+        std::cerr << "repeator-pipe: invalid rate or channel count" << std::endl;
+        return 1;
+    }
+
+    OfflineRenderer::Settings settings;
+    if(args.containsOption("--source"))  settings.source = args.getValueForOption("--source");
+    if(args.containsOption("--period"))  settings.periodInSec = args.getValueForOption("--period").getFloatValue();
+    if(args.containsOption("--gain"))    settings.gainInDb = args.getValueForOption("--gain").getFloatValue();
+    if(args.containsOption("--block"))   settings.blockSize = jlimit(16, 1 << 16, args.getValueForOption("--block").getIntValue());
+
+    if(! OfflineRenderer::isKnownSource(settings.source))
+    {
+        std::cerr << "repeator-pipe: unknown source " << settings.source << ", not a built-in or an existing file" << std::endl;
+        return 1;
+    }
+
+    //==============================================================================
+    RepeatorAudioProcessor processor;
+    OfflineRenderer renderer(processor);
+
+    //nothing is written before the source loaded, a stream without the watermark must not look like a result
+    if(! renderer.prepare(settings, sampleRate, numChannels))
+    {
+        std::cerr << "repeator-pipe: could not load the source " << settings.source << std::endl;
+        return 1;
+    }
+
+    const int blockSize = settings.blockSize;
+    const int inFrameBytes = numChannels * getBytesPerSample(inFormat);
+    const int outFrameBytes = numChannels * getBytesPerSample(outFormat);
+
+    //everything is allocated once, memory doesn't grow with the stream
+    HeapBlock<uint8> inBytes(static_cast<size_t>(blockSize * inFrameBytes));
+    HeapBlock<uint8> outBytes(static_cast<size_t>(blockSize * outFrameBytes));
+    AudioBuffer<float> block(numChannels, blockSize);
+
+    std::setvbuf(stdout, nullptr, _IOFBF, static_cast<size_t>(blockSize * outFrameBytes));
+
+    if(isWavOut)
+        writeWavHeader(sampleRate, numChannels, outFormat);
+
+    const double startTime = Time::getMillisecondCounterHiRes();
+    int64 numFrames = 0;
+
+    for(;;)
+    {
+        const size_t numRead = std::fread(inBytes, 1, static_cast<size_t>(blockSize * inFrameBytes), stdin);
+        const int numBlockFrames = static_cast<int>(numRead / static_cast<size_t>(inFrameBytes));
+
+        if(numBlockFrames == 0)
+            break;
+
+        deinterleave(inBytes, inFormat, block.getArrayOfWritePointers(), numChannels, numBlockFrames);
+        renderer.process(block.getArrayOfWritePointers(), numChannels, numBlockFrames);
+        interleave(block.getArrayOfReadPointers(), numChannels, outFormat, outBytes, numBlockFrames);
+
+        if(std::fwrite(outBytes, static_cast<size_t>(outFrameBytes), static_cast<size_t>(numBlockFrames), stdout)
+            != static_cast<size_t>(numBlockFrames))
+            return 2; //the reader went away
+
+        numFrames += numBlockFrames;
+
+        if(numRead < static_cast<size_t>(blockSize * inFrameBytes))
+            break;
+    }
+
+    std::fflush(stdout);
+
+    if(args.containsOption("--stats"))
+    {
+        const double wallSeconds = jmax(1.0e-6, (Time::getMillisecondCounterHiRes() - startTime) / 1000.0);
+
+        std::cerr << "repeator-pipe: " << numFrames << " frames in " << String(wallSeconds, 2) << " s, "
+                  << String(numFrames / sampleRate / wallSeconds, 1) << "x realtime" << std::endl;
+    }
+
+    return 0;
+}
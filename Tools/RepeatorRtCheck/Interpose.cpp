@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    Interpose.cpp
+    Created: 22 Oct 2026 9:40:51am
+    Author:  Voyagers Audio
+
+    The checker half of RealtimeCheck.h. Only linked into repeator-rtcheck:
+    the executable defines malloc, free, pthread_mutex_lock and the blocking
+    calls itself, so every library in the process resolves them to these.
+    Each one reports when the calling thread is inside a ScopedRealtime, then
+    forwards to the C library.
+
+    Allocations are caught on glibc, locks and blocking calls on every ELF
+    platform. Elsewhere only operator new and delete are replaced.
+
+  ==============================================================================
+*/
+
+#include "../../Source/RealtimeCheck.h"
+
+#if ! REPEATOR_RT_CHECK
+ #error "repeator-rtcheck needs REPEATOR_RT_CHECK=1"
+#endif
+
+#if JUCE_LINUX || JUCE_BSD
+ #define REPEATOR_RT_INTERPOSE_CALLS 1
+#else
+ #define REPEATOR_RT_INTERPOSE_CALLS 0
+#endif
+
+#include <cerrno>
+#include <cstdarg>
+
+#if REPEATOR_RT_INTERPOSE_CALLS
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #include <fcntl.h>
+ #include <poll.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <sys/select.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+ #define REPEATOR_RT_INTERPOSE_MALLOC 1
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+}
+#else
+ #define REPEATOR_RT_INTERPOSE_MALLOC 0
+#endif
+
+
+namespace
+{
+    std::atomic<int> numViolations { 0 };
+    bool shouldAbort = false;
+
+    //writes straight to stderr, the report itself must not allocate or lock
+    void writeError(const char* text) noexcept
+    {
+       #if REPEATOR_RT_INTERPOSE_CALLS
+        ::syscall(SYS_write, 2, text, std::strlen(text));
+       #else
+        std::fputs(text, stderr);
+       #endif
+    }
+
+    void reportViolation(const char* call) noexcept
+    {
+        if(! RealtimeCheck::isRealtime())
+            return;
+
+        //whatever the report itself calls isn't reported again
+        const RealtimeCheck::ScopedNonRealtime nonRealtime;
+
+        numViolations++;
+
+        writeError("\n[rtcheck] ");
+        writeError(call);
+        writeError(" called from the audio thread\n");
+
+       #if REPEATOR_RT_INTERPOSE_CALLS
+        void* frames[48];
+        const int numFrames = ::backtrace(frames, 48);
+
+        //skips this function and the interposer
+        if(numFrames > 2)
+            ::backtrace_symbols_fd(frames + 2, numFrames - 2, 2);
+       #endif
+
+        if(shouldAbort)
+            std::abort();
+    }
+
+   #if REPEATOR_RT_INTERPOSE_CALLS
+    //the next definition of a symbol after this executable, resolved once before main
+    template<typename Function>
+    Function findNext(const char* name) noexcept
+    {
+        return reinterpret_cast<Function>(::dlsym(RTLD_NEXT, name));
+    }
+
+    struct RealFunctions
+    {
+        RealFunctions()
+        {
+            //backtrace loads libgcc the first time, which allocates
+            void* frame;
+            ::backtrace(&frame, 1);
+
+            shouldAbort = ::getenv("REPEATOR_RT_CHECK_ABORT") != nullptr;
+        }
+
+        decltype(&::pthread_mutex_lock) mutexLock = findNext<decltype(&::pthread_mutex_lock)>("pthread_mutex_lock");
+        decltype(&::pthread_rwlock_rdlock) readLock = findNext<decltype(&::pthread_rwlock_rdlock)>("pthread_rwlock_rdlock");
+        decltype(&::pthread_rwlock_wrlock) writeLock = findNext<decltype(&::pthread_rwlock_wrlock)>("pthread_rwlock_wrlock");
+        decltype(&::pthread_cond_wait) conditionWait = findNext<decltype(&::pthread_cond_wait)>("pthread_cond_wait");
+        decltype(&::pthread_cond_timedwait) conditionTimedWait = findNext<decltype(&::pthread_cond_timedwait)>("pthread_cond_timedwait");
+        decltype(&::sem_wait) semaphoreWait = findNext<decltype(&::sem_wait)>("sem_wait");
+        decltype(&::nanosleep) nanosleep = findNext<decltype(&::nanosleep)>("nanosleep");
+        decltype(&::usleep) usleep = findNext<decltype(&::usleep)>("usleep");
+        decltype(&::read) read = findNext<decltype(&::read)>("read");
+        decltype(&::write) write = findNext<decltype(&::write)>("write");
+        decltype(&::pread) pread = findNext<decltype(&::pread)>("pread");
+        decltype(&::close) close = findNext<decltype(&::close)>("close");
+        decltype(&::fsync) fsync = findNext<decltype(&::fsync)>("fsync");
+        decltype(&::poll) poll = findNext<decltype(&::poll)>("poll");
+        decltype(&::select) select = findNext<decltype(&::select)>("select");
+
+        using OpenFunction = int (*) (const char*, int, ...);
+        OpenFunction open = findNext<OpenFunction>("open");
+    };
+
+    RealFunctions& getReal() noexcept
+    {
+        static RealFunctions functions;
+        return functions;
+    }
+
+    //resolved before main, so no audio thread ever runs dlsym
+    const RealFunctions& realFunctionsAtStartup = getReal();
+   #endif
+}
+
+
+//==============================================================================
+int RealtimeCheck::getNumViolations() noexcept
+{
+    return numViolations.load();
+}
+
+
+//==============================================================================
+#if REPEATOR_RT_INTERPOSE_MALLOC
+extern "C"
+{
+    void* malloc(size_t size)
+    {
+        reportViolation("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        reportViolation("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        reportViolation("realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void* pointer)
+    {
+        if(pointer != nullptr)
+            reportViolation("free");
+
+        __libc_free(pointer);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        reportViolation("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size)
+    {
+        reportViolation("posix_memalign");
+
+        if(alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+}
+#else
+//new and delete are all that can be replaced portably
+void* operator new(size_t size)
+{
+    reportViolation("operator new");
+
+    if(void* pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if(pointer != nullptr)
+        reportViolation("operator delete");
+
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+#endif
+
+//==============================================================================
+#if REPEATOR_RT_INTERPOSE_CALLS
+extern "C"
+{
+    int pthread_mutex_lock(pthread_mutex_t* mutex)
+    {
+        reportViolation("pthread_mutex_lock");
+        return getReal().mutexLock(mutex);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock)
+    {
+        reportViolation("pthread_rwlock_rdlock");
+        return getReal().readLock(lock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock)
+    {
+        reportViolation("pthread_rwlock_wrlock");
+        return getReal().writeLock(lock);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        reportViolation("pthread_cond_wait");
+        return getReal().conditionWait(condition, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* time)
+    {
+        reportViolation("pthread_cond_timedwait");
+        return getReal().conditionTimedWait(condition, mutex, time);
+    }
+
+    int sem_wait(sem_t* semaphore)
+    {
+        reportViolation("sem_wait");
+        return getReal().semaphoreWait(semaphore);
+    }
+
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        reportViolation("nanosleep");
+        return getReal().nanosleep(duration, remaining);
+    }
+
+    int usleep(useconds_t microseconds)
+    {
+        reportViolation("usleep");
+        return getReal().usleep(microseconds);
+    }
+
+    ssize_t read(int fd, void* buffer, size_t size)
+    {
+        reportViolation("read");
+        return getReal().read(fd, buffer, size);
+    }
+
+    ssize_t write(int fd, const void* buffer, size_t size)
+    {
+        reportViolation("write");
+        return getReal().write(fd, buffer, size);
+    }
+
+    ssize_t pread(int fd, void* buffer, size_t size, off_t offset)
+    {
+        reportViolation("pread");
+        return getReal().pread(fd, buffer, size, offset);
+    }
+
+    int open(const char* path, int flags, ...)
+    {
+        reportViolation("open");
+
+        mode_t mode = 0;
+
+        if((flags & O_CREAT) != 0)
+        {
+            va_list args;
+            va_start(args, flags);
+            mode = static_cast<mode_t>(va_arg(args, int));
+            va_end(args);
+        }
+
+        return getReal().open(path, flags, mode);
+    }
+
+    int close(int fd)
+    {
+        reportViolation("close");
+        return getReal().close(fd);
+    }
+
+    int fsync(int fd)
+    {
+        reportViolation("fsync");
+        return getReal().fsync(fd);
+    }
+
+    int poll(struct pollfd* fds, nfds_t numFds, int timeout)
+    {
+        reportViolation("poll");
+        return getReal().poll(fds, numFds, timeout);
+    }
+
+    int select(int numFds, fd_set* readFds, fd_set* writeFds, fd_set* exceptFds, struct timeval* timeout)
+    {
+        reportViolation("select");
+        return getReal().select(numFds, readFds, writeFds, exceptFds, timeout);
+    }
+}
+#endif
@@ -0,0 +1,307 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 22 Oct 2026 11:02:17am
+    Author:  Voyagers Audio
+
+    repeator-rtcheck: plays the processor on its own audio thread while the
+    message thread switches sources, loads files, restores states and changes
+    the host setup. Built with REPEATOR_RT_CHECK=1, so any allocation, lock or
+    blocking call inside processBlock is reported with its call stack, and the
+    run fails. It also fails when two fresh instances play the same noise.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Common/OfflineRenderer.h"
+
+
+namespace
+{
+    const char* usage =
+        "usage: repeator-rtcheck [options]\n"
+        "\n"
+        "  --step=<ms>   how long every step plays before the next one (default 250)\n"
+        "\n"
+        "set REPEATOR_RT_CHECK_ABORT=1 to abort on the first violation, e.g. under a debugger\n";
+
+    //==============================================================================
+    /**
+     The host's audio callback: one block at a time at roughly the real pace,
+     stopped around prepareToPlay like a host does.
+     */
+    class AudioThread : public Thread
+    {
+    public:
+        AudioThread(RepeatorAudioProcessor& processor)
+            : Thread("repeator-rtcheck audio"),
+              mProcessor(processor)
+        {
+            mProcessor.setPlayHead(&mPlayHead);
+        }
+
+        ~AudioThread() override
+        {
+            stopThread(5000);
+            mProcessor.setPlayHead(nullptr);
+        }
+
+        void configure(double sampleRate, int blockSize, int numChannels, bool isDoublePrecision)
+        {
+            stopThread(5000);
+
+            mProcessor.setProcessingPrecision(isDoublePrecision ? AudioProcessor::doublePrecision
+                                                                : AudioProcessor::singlePrecision);
+            mProcessor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+            mProcessor.prepareToPlay(sampleRate, blockSize);
+
+            mFloatBuffer.setSize(numChannels, isDoublePrecision ? 0 : blockSize);
+            mDoubleBuffer.setSize(numChannels, isDoublePrecision ? blockSize : 0);
+            mIsDoublePrecision = isDoublePrecision;
+            mBlockMs = jmax(1, roundToInt(1000. * blockSize / sampleRate));
+
+            mPlayHead.setSampleRate(sampleRate);
+            mPlayHead.setPosition(0);
+
+            startThread(Thread::Priority::highest);
+        }
+
+        int getNumBlocks() const noexcept { return mNumBlocks.load(); }
+
+        void run() override
+        {
+            while(! threadShouldExit())
+            {
+                if(mIsDoublePrecision)
+                    processBlock(mDoubleBuffer);
+                else
+                    processBlock(mFloatBuffer);
+
+                wait(mBlockMs);
+            }
+        }
+
+    private:
+        template<typename SampleType>
+        void processBlock(AudioBuffer<SampleType>& buffer)
+        {
+            //some input to mix into, filled outside the checked section
+            for(int channel = 0; channel < buffer.getNumChannels(); channel++)
+                for(int i = 0; i < buffer.getNumSamples(); i++)
+                    buffer.setSample(channel, i, static_cast<SampleType>(0.01 * std::sin(0.03 * (mPlayHead.getTimeInSamples() + i))));
+
+            mProcessor.processBlock(buffer, mMidi);
+
+            mPlayHead.setPosition(mPlayHead.getTimeInSamples() + buffer.getNumSamples());
+            mNumBlocks++;
+        }
+
+        RepeatorAudioProcessor& mProcessor;
+        OfflinePlayHead mPlayHead;
+        MidiBuffer mMidi;
+
+        AudioBuffer<float> mFloatBuffer;
+        AudioBuffer<double> mDoubleBuffer;
+        bool mIsDoublePrecision = false;
+        int mBlockMs = 5;
+
+        std::atomic<int> mNumBlocks { 0 };
+    };
+
+    //==============================================================================
+    //two seconds of a fresh instance in noise mode, a trigger at one second
+    AudioBuffer<float> renderFreshNoise()
+    {
+        RepeatorAudioProcessor processor;
+        OfflineRenderer renderer(processor);
+
+        OfflineRenderer::Settings settings;
+        settings.source = "noise";
+        settings.periodInSec = 1.f;
+
+        AudioBuffer<float> buffer(2, 96000);
+        buffer.clear();
+
+        if(renderer.prepare(settings, 48000., 2))
+            renderer.process(buffer);
+
+        return buffer;
+    }
+
+    //==============================================================================
+    //a sine with a decaying tail, written as 16-bit WAV
+    File writeTestFile(const File& directory, const String& name, double sampleRate, int numChannels, double seconds)
+    {
+        const File file = directory.getChildFile(name);
+        const int numSamples = roundToInt(seconds * sampleRate);
+
+        AudioBuffer<float> buffer(numChannels, numSamples);
+        for(int channel = 0; channel < numChannels; channel++)
+            for(int i = 0; i < numSamples; i++)
+                buffer.setSample(channel, i, 0.5f * std::exp(-3.f * i / numSamples)
+                                                  * std::sin(MathConstants<float>::twoPi * 440.f * (channel + 1) * i / static_cast<float>(sampleRate)));
+
+        file.deleteFile();
+        std::unique_ptr<FileOutputStream> stream(file.createOutputStream());
+        std::unique_ptr<AudioFormatWriter> writer(WavAudioFormat().createWriterFor(stream.get(), sampleRate,
+                                                                                   static_cast<unsigned int>(numChannels), 16, {}, 0));
+        if(writer == nullptr)
+            return {};
+
+        stream.release(); //the writer owns it now
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        return file;
+    }
+}
+
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ArgumentList args(argc, argv);
+
+    if(args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    const int stepMs = args.containsOption("--step") ? jmax(10, args.getValueForOption("--step").getIntValue()) : 250;
+
+    //==============================================================================
+    //every instance seeds its own noise, identical noise would add up coherently across stems
+    const auto firstNoise = renderFreshNoise();
+    const auto secondNoise = renderFreshNoise();
+
+    bool isNoiseShared = firstNoise.getMagnitude(0, firstNoise.getNumSamples()) == 0.f;
+    if(! isNoiseShared)
+    {
+        isNoiseShared = true;
+
+        for(int channel = 0; channel < firstNoise.getNumChannels() && isNoiseShared; channel++)
+            isNoiseShared = std::memcmp(firstNoise.getReadPointer(channel), secondNoise.getReadPointer(channel),
+                                        sizeof(float) * static_cast<size_t>(firstNoise.getNumSamples())) == 0;
+    }
+
+    std::cout << "  0  fresh instances play " << (isNoiseShared ? "the same noise" : "different noise") << std::endl;
+
+    //==============================================================================
+    //one file for each way a sample is held: mapped, decoded and resampled, and streamed
+    const File directory = File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("repeator-rtcheck", {}, false);
+    directory.createDirectory();
+
+    const File mappedFile = writeTestFile(directory, "mapped.wav", 48000., 2, 1.);
+    const File resampledFile = writeTestFile(directory, "resampled.wav", 44100., 1, 1.);
+    const File streamedFile = writeTestFile(directory, "streamed.wav", 44100., 2, 25.);
+
+    if(! mappedFile.existsAsFile() || ! resampledFile.existsAsFile() || ! streamedFile.existsAsFile())
+    {
+        std::cerr << "can't write the test files" << std::endl;
+        directory.deleteRecursively();
+        return 1;
+    }
+
+    RepeatorAudioProcessor processor;
+    OfflineRenderer::setParameter(processor, "PERIOD", 1.f);
+
+    AudioThread audioThread(processor);
+
+    int stepNumber = 0;
+    auto step = [&] (const String& description, std::function<void()> action)
+    {
+        std::cout << String(++stepNumber).paddedLeft(' ', 3) << "  " << description << std::endl;
+        action();
+        processor.waitForSampleLoad(30000);
+        Thread::sleep(stepMs);
+    };
+
+    auto selectSources = [&]
+    {
+        for(auto source : { "bypass", "silence", "noise", "beep" })
+            step(String("source ") + source, [&] { OfflineRenderer::selectSource(processor, source); });
+
+        for(auto& file : { mappedFile, resampledFile, streamedFile })
+            step("load " + file.getFileName(), [&] { OfflineRenderer::selectSource(processor, file.getFullPathName()); });
+    };
+
+    //==============================================================================
+    step("prepare 48 kHz, 256 samples, stereo", [&] { audioThread.configure(48000., 256, 2, false); });
+    selectSources();
+
+    step("gain ramps", [&]
+    {
+        for(float gain : { -30.f, 12.f, -6.f, 0.f })
+        {
+            OfflineRenderer::setParameter(processor, "GAIN", gain);
+            Thread::sleep(stepMs / 4);
+        }
+    });
+
+    step("noise colours", [&]
+    {
+        OfflineRenderer::selectSource(processor, "noise");
+
+        for(float colour : { 1.f, 2.f, 0.f })
+        {
+            OfflineRenderer::setParameter(processor, "NOISE", colour);
+            Thread::sleep(stepMs / 4);
+        }
+    });
+
+    step("custom channel matrix", [&]
+    {
+        OfflineRenderer::selectSource(processor, streamedFile.getFullPathName());
+        processor.waitForSampleLoad(30000);
+        processor.setChannelMatrix("0.5 0.5; 0.5 0.5");
+        Thread::sleep(stepMs);
+        processor.setChannelMatrix({});
+    });
+
+    step("jittered and listed triggers", [&]
+    {
+        auto& scheduler = processor.getTriggerScheduler();
+        scheduler.setJitter(0.5f, 1234);
+        Thread::sleep(stepMs / 2);
+        scheduler.setList({ 0.1, 0.25, 0.3, 0.9, 1.5 });
+        Thread::sleep(stepMs / 2);
+        scheduler.setBars(1);
+        Thread::sleep(stepMs / 2);
+        scheduler.setGrid();
+    });
+
+    MemoryBlock streamedState;
+    step("save state", [&] { processor.getStateInformation(streamedState); });
+
+    step("restore state over beep", [&]
+    {
+        OfflineRenderer::selectSource(processor, "beep");
+        processor.waitForSampleLoad(30000);
+        Thread::sleep(stepMs);
+        processor.setStateInformation(streamedState.getData(), static_cast<int>(streamedState.getSize()));
+    });
+
+    step("restore the same state again", [&]
+    {
+        processor.setStateInformation(streamedState.getData(), static_cast<int>(streamedState.getSize()));
+    });
+
+    step("prepare 96 kHz, 64 samples, 5.1", [&] { audioThread.configure(96000., 64, 6, false); });
+    selectSources();
+
+    step("prepare 44.1 kHz, 1024 samples, stereo, double precision", [&] { audioThread.configure(44100., 1024, 2, true); });
+    selectSources();
+
+    audioThread.stopThread(5000);
+    directory.deleteRecursively();
+
+    //==============================================================================
+    const int numViolations = RealtimeCheck::getNumViolations();
+
+    std::cout << audioThread.getNumBlocks() << " blocks, " << numViolations << " realtime violations" << std::endl;
+
+    return numViolations == 0 && ! isNoiseShared ? 0 : 1;
+}
@@ -0,0 +1,375 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 21 Oct 2026 2:31:48pm
+    Author:  Voyagers Audio
+
+    repeator-stress: loads a session of N instances from one saved state and
+    runs them in parallel the way a DAW graph does, to see how memory, load
+    time and CPU grow with the instance count.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Common/OfflineRenderer.h"
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+ #include <sys/resource.h>
+ #include <unistd.h>
+#endif
+
+#if JUCE_MAC
+ #include <mach/mach.h>
+#endif
+
+
+namespace
+{
+    const char* usage =
+        "usage: repeator-stress [options]\n"
+        "\n"
+        "  --instances=<n>                     instances in the session, 1 to 1000 (default 100)\n"
+        "  --state=<file>                      state saved with --save-state, or by a host\n"
+        "  --source=<beep|noise|silence|file>  the source of the generated state (default beep)\n"
+        "  --save-state=<file>                 writes the state used to a file and exits\n"
+        "  --rate=<Hz>                         sample rate (default 48000)\n"
+        "  --channels=<n>                      channels per instance (default 2)\n"
+        "  --block=<samples>                   block size (default 256)\n"
+        "  --threads=<n>                       graph threads (default: all cores)\n"
+        "  --seconds=<seconds>                 audio rendered by every instance (default 10)\n";
+
+    //==============================================================================
+    //resident memory of the process in bytes, -1 where it isn't known
+    int64 getCurrentRss()
+    {
+       #if JUCE_LINUX || JUCE_BSD
+        const StringArray fields = StringArray::fromTokens(File("/proc/self/statm").loadFileAsString(), " ", {});
+        return fields.size() > 1 ? fields[1].getLargeIntValue() * static_cast<int64>(sysconf(_SC_PAGESIZE)) : -1;
+       #elif JUCE_MAC
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+            return -1;
+        return static_cast<int64>(info.resident_size);
+       #else
+        return -1;
+       #endif
+    }
+
+    int64 getPeakRss()
+    {
+       #if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        #if JUCE_MAC
+         return static_cast<int64>(usage.ru_maxrss);
+        #else
+         return static_cast<int64>(usage.ru_maxrss) * 1024;
+        #endif
+       #else
+        return -1;
+       #endif
+    }
+
+    //user and system time of every thread of the process, in seconds
+    double getProcessCpuSeconds()
+    {
+       #if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+             + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1.0e6;
+       #else
+        return 0.;
+       #endif
+    }
+
+    String formatBytes(int64 bytes)
+    {
+        return bytes < 0 ? String("n/a") : File::descriptionOfSizeInBytes(bytes);
+    }
+
+    //==============================================================================
+    struct Instance
+    {
+        Instance(int numChannels, int blockSize)
+            : buffer(numChannels, blockSize)
+        {
+            processor.setPlayHead(&playHead);
+        }
+
+        ~Instance()
+        {
+            processor.releaseResources();
+            processor.setPlayHead(nullptr);
+        }
+
+        RepeatorAudioProcessor processor;
+        OfflinePlayHead playHead;
+        AudioBuffer<float> buffer;
+        MidiBuffer midi;
+        int64 processingTicks = 0;
+    };
+
+    //==============================================================================
+    /**
+     One cycle processes every instance once, like one callback of a host graph.
+     Workers take instances from a shared counter and the cycle ends when every
+     worker ran out of instances, so the slowest thread decides the cycle time.
+     */
+    class GraphRunner
+    {
+    public:
+        GraphRunner(OwnedArray<Instance>& instances, int numThreads)
+            : mInstances(instances),
+              mPool(numThreads)
+        {
+            for(int i = 0; i < numThreads; i++)
+                mWorkers.add(new Worker(*this));
+
+            for(auto* worker : mWorkers)
+                mPool.addJob(worker, false);
+        }
+
+        ~GraphRunner()
+        {
+            mShouldExit.store(true);
+            for(auto* worker : mWorkers)
+                worker->start.signal();
+
+            mPool.removeAllJobs(true, 10000);
+        }
+
+        //processes one block on every instance and returns once all are done
+        void runCycle()
+        {
+            mNumFinished.store(0);
+            mNextInstance.store(0);
+
+            for(auto* worker : mWorkers)
+                worker->start.signal();
+
+            mCycleDone.wait();
+        }
+
+    private:
+        //==============================================================================
+        struct Worker : public ThreadPoolJob
+        {
+            Worker(GraphRunner& owner)
+                : ThreadPoolJob("repeator-stress graph"),
+                  mOwner(owner)
+            {
+            }
+
+            JobStatus runJob() override
+            {
+                for(;;)
+                {
+                    start.wait();
+
+                    if(mOwner.mShouldExit.load())
+                        return jobHasFinished;
+
+                    mOwner.processInstances();
+
+                    if(++mOwner.mNumFinished == mOwner.mWorkers.size())
+                        mOwner.mCycleDone.signal();
+                }
+            }
+
+            WaitableEvent start;
+            GraphRunner& mOwner;
+        };
+
+        void processInstances()
+        {
+            const int numInstances = mInstances.size();
+
+            for(int index = mNextInstance++; index < numInstances; index = mNextInstance++)
+            {
+                auto& instance = *mInstances.getUnchecked(index);
+                const int numSamples = instance.buffer.getNumSamples();
+
+                const int64 start = Time::getHighResolutionTicks();
+                instance.processor.processBlock(instance.buffer, instance.midi);
+                instance.processingTicks += Time::getHighResolutionTicks() - start;
+
+                instance.playHead.setPosition(instance.playHead.getTimeInSamples() + numSamples);
+            }
+        }
+
+        //==============================================================================
+        OwnedArray<Instance>& mInstances;
+        ThreadPool mPool;
+        OwnedArray<Worker> mWorkers;
+
+        std::atomic<int> mNextInstance { 0 };
+        std::atomic<int> mNumFinished { 0 };
+        std::atomic<bool> mShouldExit { false };
+        WaitableEvent mCycleDone;
+    };
+}
+
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ArgumentList args(argc, argv);
+
+    if(args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    const int numInstances = args.containsOption("--instances") ? jlimit(1, 1000, args.getValueForOption("--instances").getIntValue()) : 100;
+    const double sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.;
+    const int numChannels = args.containsOption("--channels") ? jlimit(1, 64, args.getValueForOption("--channels").getIntValue()) : 2;
+    const int blockSize = args.containsOption("--block") ? jlimit(16, 1 << 16, args.getValueForOption("--block").getIntValue()) : 256;
+    const int numThreads = args.containsOption("--threads") ? jmax(1, args.getValueForOption("--threads").getIntValue()) : SystemStats::getNumCpus();
+    const double seconds = args.containsOption("--seconds") ? jmax(0.1, args.getValueForOption("--seconds").getDoubleValue()) : 10.;
+
+    const int64 baselineRss = getCurrentRss();
+
+    //==============================================================================
+    //the saved session, from a file or from an instance set up like the editor would
+    MemoryBlock state;
+
+    if(args.containsOption("--state"))
+    {
+        const File stateFile = args.getExistingFileForOption("--state");
+        if(! stateFile.loadFileAsData(state) || state.isEmpty())
+        {
+            std::cerr << "can't read " << stateFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        RepeatorAudioProcessor processor;
+        const String source = args.containsOption("--source") ? args.getValueForOption("--source") : String("beep");
+
+        if(! OfflineRenderer::selectSource(processor, source))
+        {
+            std::cerr << "unknown source " << source << std::endl;
+            return 1;
+        }
+
+        OfflineRenderer::setParameter(processor, "PERIOD", 1.f);
+        processor.waitForSampleLoad(60000);
+        processor.getStateInformation(state);
+    }
+
+    if(args.containsOption("--save-state"))
+    {
+        const File output = args.getFileForOption("--save-state");
+        if(! output.replaceWithData(state.getData(), state.getSize()))
+        {
+            std::cerr << "can't write " << output.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    std::cout << "repeator-stress: " << numInstances << " instances, " << numThreads << " threads, "
+              << numChannels << " ch, " << sampleRate << " Hz, " << blockSize << " samples per block" << std::endl;
+
+    //==============================================================================
+    //session load: every instance is created and restored on the message thread, then prepared
+    OwnedArray<Instance> instances;
+    const int64 rssBeforeLoad = getCurrentRss();
+    const double loadStart = Time::getMillisecondCounterHiRes();
+
+    for(int i = 0; i < numInstances; i++)
+    {
+        auto* instance = instances.add(new Instance(numChannels, blockSize));
+        instance->processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        instance->processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+        instance->processor.prepareToPlay(sampleRate, blockSize);
+        instance->playHead.setSampleRate(sampleRate);
+    }
+
+    const double createdTime = Time::getMillisecondCounterHiRes();
+
+    //every instance decodes on the one shared pool
+    auto& pool = instances.getFirst()->processor.getSampleLoaderPool();
+    const auto progress = pool.getProgress();
+
+    if(! pool.waitUntilIdle(120000))
+    {
+        std::cerr << "timed out waiting for the samples to load" << std::endl;
+        return 2;
+    }
+
+    const double loadEnd = Time::getMillisecondCounterHiRes();
+    const int64 rssAfterLoad = getCurrentRss();
+
+    std::cout << "session load:  " << String((loadEnd - loadStart) / 1000., 3) << " s ("
+              << String((createdTime - loadStart) / 1000., 3) << " s creating and restoring, "
+              << String((loadEnd - createdTime) / 1000., 3) << " s waiting for " << progress.numJobs - progress.numFinished
+              << " decodes on " << pool.getNumThreads() << " threads)" << std::endl;
+
+    //==============================================================================
+    const int numCycles = jmax(1, roundToInt(seconds * sampleRate / blockSize));
+    const double cycleDurationMs = 1000. * blockSize / sampleRate;
+
+    std::vector<double> cycleMs;
+    cycleMs.reserve(static_cast<size_t>(numCycles));
+
+    const double cpuStart = getProcessCpuSeconds();
+    const double runStart = Time::getMillisecondCounterHiRes();
+
+    {
+        GraphRunner runner(instances, numThreads);
+
+        for(int cycle = 0; cycle < numCycles; cycle++)
+        {
+            //a quiet input, the same for every block
+            for(auto* instance : instances)
+                for(int channel = 0; channel < numChannels; channel++)
+                    FloatVectorOperations::fill(instance->buffer.getWritePointer(channel), 0.01f, blockSize);
+
+            const double cycleStart = Time::getMillisecondCounterHiRes();
+            runner.runCycle();
+            cycleMs.push_back(Time::getMillisecondCounterHiRes() - cycleStart);
+        }
+    }
+
+    const double runSeconds = (Time::getMillisecondCounterHiRes() - runStart) / 1000.;
+    const double cpuSeconds = getProcessCpuSeconds() - cpuStart;
+
+    int64 processingTicks = 0;
+    for(auto* instance : instances)
+        processingTicks += instance->processingTicks;
+
+    const double processingSeconds = Time::highResolutionTicksToSeconds(processingTicks);
+    const double audioSeconds = numCycles * blockSize / sampleRate;
+
+    std::sort(cycleMs.begin(), cycleMs.end());
+    const double p99CycleMs = cycleMs[jmin(cycleMs.size() - 1, static_cast<size_t>(0.99 * static_cast<double>(cycleMs.size())))];
+    const auto numLate = std::count_if(cycleMs.begin(), cycleMs.end(), [cycleDurationMs] (double ms) { return ms > cycleDurationMs; });
+
+    //==============================================================================
+    std::cout << "memory:        baseline " << formatBytes(baselineRss) << ", after load " << formatBytes(rssAfterLoad)
+              << ", peak " << formatBytes(getPeakRss()) << std::endl;
+
+    if(rssAfterLoad >= 0 && rssBeforeLoad >= 0)
+        std::cout << "per instance:  " << formatBytes((rssAfterLoad - rssBeforeLoad) / numInstances) << std::endl;
+
+    std::cout << "processing:    " << String(processingSeconds, 3) << " s of processBlock for " << String(audioSeconds, 1)
+              << " s of audio per instance, " << String(1.0e6 * processingSeconds / (numInstances * audioSeconds), 2)
+              << " us per instance per second" << std::endl
+              << "process cpu:   " << String(cpuSeconds, 3) << " s in " << String(runSeconds, 3) << " s wall, "
+              << String(100. * cpuSeconds / jmax(1.0e-6, runSeconds), 1) << "% of one core" << std::endl
+              << "graph cycles:  median " << String(cycleMs[cycleMs.size() / 2], 3) << " ms, p99 " << String(p99CycleMs, 3)
+              << " ms, max " << String(cycleMs.back(), 3) << " ms for a " << String(cycleDurationMs, 3) << " ms block, "
+              << numLate << " of " << numCycles << " late" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 10:02:33am
+    Author:  Voyagers Audio
+
+    repeator-verify: checks that rendered files carry the watermark at every
+    period and reports where and how loud each trigger was found.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Common/WatermarkVerifier.h"
+
+
+namespace
+{
+    const char* usage =
+        "usage: repeator-verify [options] <file|dir>...\n"
+        "\n"
+        "  --source=<beep|file>     the watermark that was rendered (default beep)\n"
+        "  --schedule=<grid|list>   how the triggers were placed (default grid)\n"
+        "  --period=<seconds>       time between grid triggers (default 15)\n"
+        "  --times=<list>           comma separated trigger times in seconds, for list\n"
+        "  --threshold=<0..1>       minimum correlation of a detection (default 0.3)\n"
+        "  --threads=<n>            worker threads (default: all cores)\n"
+        "  --quiet                  only print the summary line of each file\n"
+        "\n"
+        "files must be rendered from the start of the timeline, where the schedule is anchored\n";
+
+    //==============================================================================
+    //one verifier per sample rate, built the first time a file needs it
+    class VerifierCache
+    {
+    public:
+        explicit VerifierCache(const String& source) : mSource(source) {}
+
+        const WatermarkVerifier* get(double sampleRate)
+        {
+            const ScopedLock lock(mLock);
+
+            for(auto* entry : mEntries)
+                if(entry->sampleRate == sampleRate)
+                    return entry->verifier.get();
+
+            auto source = WatermarkVerifier::loadSource(mSource, sampleRate);
+            if(source.getNumSamples() == 0)
+                return nullptr;
+
+            auto* entry = mEntries.add(new Entry { sampleRate, std::make_unique<WatermarkVerifier>(source, sampleRate) });
+            return entry->verifier.get();
+        }
+
+    private:
+        struct Entry
+        {
+            double sampleRate;
+            std::unique_ptr<WatermarkVerifier> verifier;
+        };
+
+        const String mSource;
+        CriticalSection mLock;
+        OwnedArray<Entry> mEntries;
+    };
+
+    struct VerifyStats
+    {
+        std::atomic<int> numPassed { 0 };
+        std::atomic<int> numFailed { 0 };
+        std::atomic<int64> audioMicroseconds { 0 };
+    };
+
+    //==============================================================================
+    class VerifyJob : public ThreadPoolJob
+    {
+    public:
+        VerifyJob(const File& file, VerifierCache& verifiers, VerifyStats& stats,
+                  double periodInSec, const std::vector<double>& timesInSec, float threshold, bool quiet,
+                  CriticalSection& outputLock)
+            : ThreadPoolJob("repeator-verify " + file.getFileName()),
+              mFile(file), mVerifiers(verifiers), mStats(stats),
+              mPeriodInSec(periodInSec), mTimesInSec(timesInSec), mThreshold(threshold), mQuiet(quiet), mOutputLock(outputLock)
+        {
+            mFormatManager.registerBasicFormats();
+        }
+
+        JobStatus runJob() override
+        {
+            String output;
+            bool passed = false;
+
+            std::unique_ptr<AudioFormatReader> reader(mFormatManager.createReaderFor(mFile));
+            const WatermarkVerifier* verifier = reader != nullptr ? mVerifiers.get(reader->sampleRate) : nullptr;
+
+            if(verifier == nullptr)
+                output << "ERROR " << mFile.getFullPathName() << ": could not read the file or the source\n";
+            else
+            {
+                const auto report = mTimesInSec.empty() ? verifier->verify(*reader, mPeriodInSec, mThreshold)
+                                                        : verifier->verify(*reader, mTimesInSec, mThreshold);
+                passed = report.passed();
+
+                output << (passed ? "PASS " : "FAIL ") << mFile.getFullPathName() << ": "
+                       << report.detections.size() << " detections, "
+                       << report.numMissing << "/" << report.numExpected << " missing\n";
+
+                if(! mQuiet)
+                    for(auto& detection : report.detections)
+                        output << "    " << String(detection.timeInSec, 3) << " s  corr "
+                               << String(detection.correlation, 2) << "  level "
+                               << String(detection.levelInDb, 1) << " dB\n";
+
+                mStats.audioMicroseconds += static_cast<int64>(1.0e6 * report.durationInSec);
+            }
+
+            (passed ? mStats.numPassed : mStats.numFailed)++;
+
+            const ScopedLock lock(mOutputLock);
+            std::cout << output << std::flush;
+            return jobHasFinished;
+        }
+
+    private:
+        const File mFile;
+        VerifierCache& mVerifiers;
+        VerifyStats& mStats;
+        const double mPeriodInSec;
+        const std::vector<double> mTimesInSec; //list schedules, empty for the grid
+        const float mThreshold;
+        const bool mQuiet;
+        CriticalSection& mOutputLock;
+
+        AudioFormatManager mFormatManager;
+    };
+}
+
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ArgumentList args(argc, argv);
+
+    if(args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    String source = "beep";
+    double periodInSec = 15.;
+    float threshold = 0.3f;
+    int numThreads = SystemStats::getNumCpus();
+
+    if(args.containsOption("--source"))     source = args.getValueForOption("--source");
+    if(args.containsOption("--period"))     periodInSec = args.getValueForOption("--period").getDoubleValue();
+    if(args.containsOption("--threshold"))  threshold = args.getValueForOption("--threshold").getFloatValue();
+    if(args.containsOption("--threads"))    numThreads = jmax(1, args.getValueForOption("--threads").getIntValue());
+
+    const bool quiet = args.containsOption("--quiet");
+
+    //jitter and bars times depend on the seed and the host's tempo, a grid check would report them as missing
+    const String schedule = args.containsOption("--schedule") ? args.getValueForOption("--schedule") : String("grid");
+    std::vector<double> timesInSec;
+
+    if(schedule == "list")
+    {
+        for(auto& time : StringArray::fromTokens(args.getValueForOption("--times"), ",", {}))
+            if(time.trim().isNotEmpty())
+                timesInSec.push_back(time.getDoubleValue());
+
+        if(timesInSec.empty())
+        {
+            std::cerr << "repeator-verify: a list schedule needs --times" << std::endl;
+            return 1;
+        }
+    }
+    else if(schedule == "jitter" || schedule == "bars")
+    {
+        std::cerr << "repeator-verify: " << schedule << " schedules can't be verified, their trigger times aren't known here" << std::endl;
+        return 1;
+    }
+    else if(schedule != "grid")
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    //==============================================================================
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    Array<File> inputs;
+    for(auto& argument : args.arguments)
+    {
+        if(argument.isOption())
+            continue;
+
+        const File file = File::getCurrentWorkingDirectory().getChildFile(argument.text);
+
+        if(file.isDirectory())
+            inputs.addArray(file.findChildFiles(File::findFiles, true, formatManager.getWildcardForAllFormats()));
+        else
+            inputs.add(file);
+    }
+
+    if(inputs.isEmpty())
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    inputs.sort();
+
+    //==============================================================================
+    VerifierCache verifiers(source);
+    VerifyStats stats;
+    CriticalSection outputLock;
+
+    ThreadPool pool(jmin(numThreads, inputs.size()));
+
+    const double startTime = Time::getMillisecondCounterHiRes();
+
+    for(auto& file : inputs)
+        pool.addJob(new VerifyJob(file, verifiers, stats, periodInSec, timesInSec, threshold, quiet, outputLock), true);
+
+    while(pool.getNumJobs() > 0)
+        Thread::sleep(10);
+
+    const double wallSeconds = jmax(1.0e-6, (Time::getMillisecondCounterHiRes() - startTime) / 1000.0);
+    const double audioSeconds = stats.audioMicroseconds.load() / 1.0e6;
+
+    std::cout << stats.numPassed.load() << " passed, " << stats.numFailed.load() << " failed in "
+              << String(wallSeconds, 2) << " s, " << String(audioSeconds / wallSeconds, 1) << "x realtime" << std::endl;
+
+    return stats.numFailed.load() == 0 ? 0 : 2;
+}